@@ -0,0 +1,94 @@
+// aggregation_test.cpp
+
+// #include <aggregation/kll_sketch.h>
+// #include <aggregation/output_aggregator.h>
+
+#include <gtest/gtest.h>
+
+/*************************************************************************
+ * Unit Tests
+ ************************************************************************/
+
+TEST(KllSketchTest, quantilesWithinRankError)
+{
+  KllSketch sketch;
+  const size_t n = 100000;
+  for (size_t i = 0; i < n; ++i)
+  {
+    // interleave to avoid feeding sorted input
+    sketch.update(static_cast<double>((i * 7919) % n));
+  }
+
+  EXPECT_EQ(n, sketch.count());
+  for (const double q : {0.01, 0.5, 0.9, 0.99})
+  {
+    EXPECT_NEAR(q * n, sketch.quantile(q), 0.02 * n) << "q = " << q;
+  }
+}
+
+TEST(KllSketchTest, mergedSketchMatchesCombinedStream)
+{
+  KllSketch low;
+  KllSketch high;
+  for (int i = 0; i < 50000; ++i)
+  {
+    low.update(i);
+    high.update(50000 + i);
+  }
+  low.merge(high);
+
+  EXPECT_EQ(100000u, low.count());
+  EXPECT_NEAR(50000.0, low.quantile(0.5), 2000.0);
+  EXPECT_NEAR(99000.0, low.quantile(0.99), 2000.0);
+}
+
+TEST(KllSketchTest, emptySketchReturnsNaN)
+{
+  KllSketch sketch;
+  EXPECT_TRUE(std::isnan(sketch.quantile(0.5)));
+}
+
+TEST(OutputAggregatorTest, summarizesClippedOutputsPerWindow)
+{
+  const double clipping_limit = 42.0;
+  ValueModifierFactory factory;
+  Solver solver(clipping_limit, factory.makeValueModifier(IValueModifierFactory::ModifierType::SQUARE));
+  OutputAggregator aggregator(clipping_limit, 5);
+
+  for (int v = 0; v < 12; ++v)
+  {
+    solver.updateDataCb(MessageData(v));
+    aggregator.add(solver.solve());
+  }
+
+  const std::vector<OutputSummary> windows = aggregator.takeCompletedWindows();
+  ASSERT_EQ(2u, windows.size());
+  EXPECT_EQ(5u, windows[0].count);
+  EXPECT_EQ(0u, windows[0].clipped_count);
+  EXPECT_EQ(0.0, windows[0].min);
+  EXPECT_EQ(16.0, windows[0].max);
+  EXPECT_DOUBLE_EQ(6.0, windows[0].mean());
+  // 5^2 and 6^2 are below the limit; 7^2, 8^2 and 9^2 are clipped
+  EXPECT_EQ(3u, windows[1].clipped_count);
+  EXPECT_EQ(clipping_limit, windows[1].max);
+
+  EXPECT_EQ(2u, aggregator.currentWindow().count);
+  EXPECT_EQ(12u, aggregator.total().count);
+  EXPECT_EQ(5u, aggregator.total().clipped_count);
+  EXPECT_TRUE(aggregator.takeCompletedWindows().empty());
+}
+
+TEST(OutputAggregatorTest, summariesMergeAcrossWorkers)
+{
+  OutputSummary a;
+  OutputSummary b;
+  a.add(1.0, false);
+  b.add(3.0, true);
+  a.merge(b);
+
+  EXPECT_EQ(2u, a.count);
+  EXPECT_EQ(1u, a.clipped_count);
+  EXPECT_EQ(1.0, a.min);
+  EXPECT_EQ(3.0, a.max);
+  EXPECT_DOUBLE_EQ(2.0, a.mean());
+}
@@ -0,0 +1,106 @@
+// allocation_test.cpp
+//
+// Must be built with -DTRACK_ALLOCATIONS so that the global operator new/delete are replaced.
+
+// #include <testing/allocation_tracker.h>
+// #include <solver/ensemble_solver.h>
+// #include <value_modifier_factory.h>
+
+#include <gtest/gtest.h>
+
+#ifndef TRACK_ALLOCATIONS
+#error "allocation_test.cpp requires TRACK_ALLOCATIONS"
+#endif
+
+/*************************************************************************
+ * Unit Tests
+ ************************************************************************/
+
+class SteadyStateAllocationTest : public ::testing::TestWithParam<IValueModifierFactory::ModifierType>
+{
+ protected:
+  static constexpr size_t kNumMessages = 1000;
+
+  void SetUp() override
+  {
+    for (size_t i = 0; i < kNumMessages; ++i)
+    {
+      msgs_.emplace_back(1.0 + static_cast<double>(i));
+    }
+    out_.resize(kNumMessages);
+  }
+
+  ValueModifierFactory factory_;
+  std::vector<MessageData> msgs_;
+  std::vector<double> out_;
+};
+
+TEST_P(SteadyStateAllocationTest, perMessageLoopDoesNotAllocate)
+{
+  Solver solver(42.0, factory_.makeValueModifier(GetParam()));
+
+  AllocationTracker::Scope scope;
+  for (size_t i = 0; i < kNumMessages; ++i)
+  {
+    solver.updateDataCb(msgs_[i]);
+    out_[i] = solver.solve();
+  }
+
+  EXPECT_EQ(0u, scope.stats().allocations);
+}
+
+TEST_P(SteadyStateAllocationTest, batchLoopDoesNotAllocate)
+{
+  Solver solver(42.0, factory_.makeValueModifier(GetParam()));
+
+  AllocationTracker::Scope scope;
+  solver.solveBatch(msgs_.data(), out_.data(), kNumMessages);
+
+  EXPECT_EQ(0u, scope.stats().allocations);
+}
+
+INSTANTIATE_TEST_SUITE_P(AllModifierTypes,
+                         SteadyStateAllocationTest,
+                         ::testing::Values(IValueModifierFactory::ModifierType::SQUARE,
+                                           IValueModifierFactory::ModifierType::LOG));
+
+TEST(AllocationTrackerTest, countsAllocationsInScope)
+{
+  AllocationTracker::Scope scope;
+  // a direct call to the replaceable operator new, unlike a new-expression, may not be elided by the compiler
+  void* const ptr = ::operator new(100);
+  const AllocationTracker::Stats stats = scope.stats();
+  ::operator delete(ptr);
+
+  EXPECT_EQ(1u, stats.allocations);
+  EXPECT_EQ(100u, stats.bytes);
+}
+
+TEST(SteadyStateAllocationTest, expressionModifierDoesNotAllocate)
+{
+  ValueModifierFactory factory;
+  Solver solver(42.0, factory.makeExpressionValueModifier("clamp(log(x*x)+3, 0, 42)"));
+  const std::vector<MessageData> msgs(3 * ExpressionValueModifier::kBlockSize, MessageData(2.0));
+  std::vector<double> out(msgs.size());
+
+  AllocationTracker::Scope scope;
+  solver.updateDataCb(msgs[0]);
+  out[0] = solver.solve();
+  solver.solveBatch(msgs.data(), out.data(), msgs.size());
+
+  EXPECT_EQ(0u, scope.stats().allocations);
+}
+
+TEST(SteadyStateAllocationTest, ensembleSolverDoesNotAllocate)
+{
+  ValueModifierFactory factory;
+  EnsembleSolver ensemble(
+      42.0, factory, {IValueModifierFactory::ModifierType::SQUARE, IValueModifierFactory::ModifierType::LOG});
+  const std::vector<MessageData> msgs(1000, MessageData(2.0));
+  std::vector<double> out(msgs.size() * ensemble.numModifiers());
+
+  AllocationTracker::Scope scope;
+  ensemble.solveBatch(msgs.data(), out.data(), msgs.size());
+
+  EXPECT_EQ(0u, scope.stats().allocations);
+}
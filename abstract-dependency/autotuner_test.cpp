@@ -0,0 +1,167 @@
+// autotuner_test.cpp
+
+// #include <autotuning_value_modifier_factory.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+/*************************************************************************
+ * Unit Tests
+ ************************************************************************/
+
+class AutotuningValueModifierFactoryTest : public ::testing::Test
+{
+ protected:
+  void TearDown() override
+  {
+    std::remove(profile_path_.c_str());
+  }
+
+  // what a loose run would have picked if the approximate LOG implementation had won on both paths
+  static constexpr const char* kApproximateLogSelections =
+      "SQUARE per-message scalar\nSQUARE batch scalar\nLOG per-message table\nLOG batch table\n";
+
+  // the cached header (cpu, tolerance and candidates lines) of the profile at profile_path_
+  std::string profileHeader() const
+  {
+    std::string header;
+    std::ifstream in(profile_path_);
+    for (std::string line; std::getline(in, line) && line.rfind("SQUARE", 0) != 0 && line.rfind("LOG", 0) != 0;)
+    {
+      header += line + "\n";
+    }
+    return header;
+  }
+
+  const std::string profile_path_ = "/tmp/autotuner_test_" + std::to_string(getpid()) + ".profile";
+};
+
+TEST_F(AutotuningValueModifierFactoryTest, benchmarksOnceThenLoadsCachedProfile)
+{
+  using ModifierType = IValueModifierFactory::ModifierType;
+  using Usage = AutotuningValueModifierFactory::Usage;
+
+  AutotuningValueModifierFactory first(profile_path_, 1e-6);
+  EXPECT_FALSE(first.loadedFromProfile());
+
+  AutotuningValueModifierFactory second(profile_path_, 1e-6);
+  EXPECT_TRUE(second.loadedFromProfile());
+  for (const auto mod_type : {ModifierType::SQUARE, ModifierType::LOG})
+  {
+    for (const auto usage : {Usage::PER_MESSAGE, Usage::BATCH})
+    {
+      EXPECT_EQ(first.selectedImplementation(mod_type, usage), second.selectedImplementation(mod_type, usage));
+    }
+  }
+}
+
+TEST_F(AutotuningValueModifierFactoryTest, zeroToleranceExcludesApproximateCandidates)
+{
+  AutotuningValueModifierFactory factory(profile_path_, 0.0);
+
+  EXPECT_NE("table", factory.selectedImplementation(IValueModifierFactory::ModifierType::LOG));
+}
+
+TEST_F(AutotuningValueModifierFactoryTest, invalidToleranceThrows)
+{
+  EXPECT_THROW(AutotuningValueModifierFactory(profile_path_, -1e-6), std::runtime_error);
+  EXPECT_THROW(AutotuningValueModifierFactory(profile_path_, std::nan("")), std::runtime_error);
+  EXPECT_THROW(AutotuningValueModifierFactory(profile_path_, std::numeric_limits<double>::infinity()),
+               std::runtime_error);
+}
+
+TEST_F(AutotuningValueModifierFactoryTest, staleProfileIsReplaced)
+{
+  {
+    std::ofstream out(profile_path_);
+    out << "cpu some other cpu\nSQUARE scalar\nLOG table\n";
+  }
+
+  AutotuningValueModifierFactory factory(profile_path_, 0.0);
+
+  EXPECT_FALSE(factory.loadedFromProfile());
+  EXPECT_NE("table", factory.selectedImplementation(IValueModifierFactory::ModifierType::LOG));
+}
+
+TEST_F(AutotuningValueModifierFactoryTest, profileFromLooserToleranceIsReplaced)
+{
+  {
+    AutotuningValueModifierFactory loose(profile_path_, 1e-3);
+  }
+  // pretend the loose run picked the approximate LOG implementation
+  const std::string header = profileHeader();
+  {
+    std::ofstream out(profile_path_);
+    out << header << kApproximateLogSelections;
+  }
+
+  AutotuningValueModifierFactory same(profile_path_, 1e-3);
+  EXPECT_TRUE(same.loadedFromProfile());
+  EXPECT_EQ("table", same.selectedImplementation(IValueModifierFactory::ModifierType::LOG));
+
+  {
+    std::ofstream out(profile_path_);
+    out << header << kApproximateLogSelections;
+  }
+  AutotuningValueModifierFactory strict(profile_path_, 0.0);
+  EXPECT_FALSE(strict.loadedFromProfile());
+  EXPECT_NE("table", strict.selectedImplementation(IValueModifierFactory::ModifierType::LOG));
+}
+
+TEST_F(AutotuningValueModifierFactoryTest, selectionFollowsUsage)
+{
+  using Usage = AutotuningValueModifierFactory::Usage;
+  {
+    AutotuningValueModifierFactory first(profile_path_, 1e-3);
+  }
+  const std::string header = profileHeader();
+  {
+    std::ofstream out(profile_path_);
+    out << header << "SQUARE per-message scalar\nSQUARE batch batched\nLOG per-message table\nLOG batch expression\n";
+  }
+
+  AutotuningValueModifierFactory per_message(profile_path_, 1e-3, Usage::PER_MESSAGE);
+  AutotuningValueModifierFactory batch(profile_path_, 1e-3, Usage::BATCH);
+
+  ASSERT_TRUE(per_message.loadedFromProfile());
+  ASSERT_TRUE(batch.loadedFromProfile());
+  EXPECT_EQ("table", per_message.selectedImplementation(IValueModifierFactory::ModifierType::LOG));
+  EXPECT_EQ("expression", batch.selectedImplementation(IValueModifierFactory::ModifierType::LOG));
+  EXPECT_EQ("batched", batch.selectedImplementation(IValueModifierFactory::ModifierType::SQUARE));
+  EXPECT_EQ("table", batch.selectedImplementation(IValueModifierFactory::ModifierType::LOG, Usage::PER_MESSAGE));
+}
+
+TEST(ValueModifierCandidatesTest, allCandidatesAgreeWithReference)
+{
+  using ModifierType = IValueModifierFactory::ModifierType;
+
+  std::vector<MessageData> msgs;
+  for (int i = 1; i <= 1000; ++i)
+  {
+    msgs.emplace_back(0.37 * i);
+  }
+
+  for (const auto mod_type : {ModifierType::SQUARE, ModifierType::LOG})
+  {
+    const auto candidates = AutotuningValueModifierFactory::candidates(mod_type);
+    std::vector<double> reference(msgs.size());
+    candidates.front().make()->generateVals(msgs.data(), reference.data(), msgs.size());
+
+    for (const auto& candidate : candidates)
+    {
+      std::unique_ptr<IValueModifier> modifier = candidate.make();
+      std::vector<double> out(msgs.size());
+      modifier->generateVals(msgs.data(), out.data(), msgs.size());
+      for (size_t i = 0; i < msgs.size(); ++i)
+      {
+        EXPECT_NEAR(reference[i], out[i], 1e-8 * std::max(1.0, std::fabs(reference[i]))) << candidate.name;
+      }
+
+      modifier->update(msgs[7]);
+      EXPECT_NEAR(reference[7], modifier->generateVal(), 1e-8 * std::max(1.0, std::fabs(reference[7])));
+    }
+  }
+}
@@ -0,0 +1,60 @@
+// ensemble_solver_test.cpp
+
+// #include <solver/ensemble_solver.h>
+// #include <value_modifier_factory.h>
+
+#include <gtest/gtest.h>
+
+/*************************************************************************
+ * Unit Tests
+ ************************************************************************/
+
+TEST(EnsembleSolverTest, matchesIndependentSolversRowMajor)
+{
+  using ModifierType = IValueModifierFactory::ModifierType;
+
+  const double clipping_limit = 42.0;
+  const std::vector<ModifierType> mod_types{ModifierType::SQUARE, ModifierType::LOG, ModifierType::SQUARE};
+
+  ValueModifierFactory factory;
+  EnsembleSolver ensemble(clipping_limit, factory, mod_types);
+  ASSERT_EQ(mod_types.size(), ensemble.numModifiers());
+
+  const size_t n = 2 * EnsembleSolver::kTileSize + 3;
+  std::vector<MessageData> msgs;
+  for (size_t i = 0; i < n; ++i)
+  {
+    msgs.emplace_back(1.0 + 0.1 * static_cast<double>(i));
+  }
+
+  std::vector<double> out(n * mod_types.size());
+  ensemble.solveBatch(msgs.data(), out.data(), n);
+
+  for (size_t m = 0; m < mod_types.size(); ++m)
+  {
+    Solver solver(clipping_limit, factory.makeValueModifier(mod_types[m]));
+    for (size_t i = 0; i < n; ++i)
+    {
+      solver.updateDataCb(msgs[i]);
+      EXPECT_DOUBLE_EQ(solver.solve(), out[i * mod_types.size() + m]);
+    }
+  }
+}
+
+TEST(EnsembleSolverTest, clipsEveryModifierOutput)
+{
+  ValueModifierFactory factory;
+  EnsembleSolver ensemble(3.0, factory, {IValueModifierFactory::ModifierType::SQUARE});
+
+  const MessageData msg(10.0);
+  double out = 0;
+  ensemble.solveBatch(&msg, &out, 1);
+
+  EXPECT_EQ(3.0, out);
+}
+
+TEST(EnsembleSolverTest, emptyEnsembleThrows)
+{
+  ValueModifierFactory factory;
+  EXPECT_THROW(EnsembleSolver(42.0, factory, {}), std::runtime_error);
+}
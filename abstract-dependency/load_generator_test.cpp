@@ -0,0 +1,104 @@
+// load_generator_test.cpp
+
+// #include <load_generator/latency_histogram.h>
+// #include <load_generator/load_generator.h>
+
+#include <gtest/gtest.h>
+
+/*************************************************************************
+ * Unit Tests
+ ************************************************************************/
+
+TEST(LatencyHistogramTest, percentilesWithinBucketPrecision)
+{
+  LatencyHistogram histogram;
+  for (uint64_t v = 1; v <= 100000; ++v)
+  {
+    histogram.record(v);
+  }
+
+  EXPECT_EQ(100000u, histogram.count());
+  EXPECT_EQ(100000u, histogram.max());
+  EXPECT_NEAR(50000.0, static_cast<double>(histogram.percentile(50)), 50000.0 * 0.04);
+  EXPECT_NEAR(99000.0, static_cast<double>(histogram.percentile(99)), 99000.0 * 0.04);
+  EXPECT_EQ(100000u, histogram.percentile(100));
+}
+
+TEST(LatencyHistogramTest, smallValuesAreExact)
+{
+  LatencyHistogram histogram;
+  histogram.record(3);
+  histogram.record(7);
+
+  EXPECT_EQ(3u, histogram.percentile(50));
+  EXPECT_EQ(7u, histogram.percentile(99));
+}
+
+TEST(LatencyHistogramTest, mergeCombinesCounts)
+{
+  LatencyHistogram a;
+  LatencyHistogram b;
+  a.record(10);
+  b.record(1000000);
+  a.merge(b);
+
+  EXPECT_EQ(2u, a.count());
+  EXPECT_EQ(1000000u, a.max());
+}
+
+TEST(LoadGeneratorTest, issuesScheduledRequestsPerModifierType)
+{
+  ValueModifierFactory factory;
+  LoadGeneratorConfig config;
+  config.rate_per_sec = 20000;
+  config.num_threads = 2;
+  config.duration_sec = 0.05;
+  config.arrival = LoadGeneratorConfig::Arrival::POISSON;
+  config.mod_types = {IValueModifierFactory::ModifierType::SQUARE, IValueModifierFactory::ModifierType::LOG};
+
+  const LoadGeneratorResult result = runLoadGenerator(factory, config);
+
+  EXPECT_EQ(result.scheduled, result.completed);
+  EXPECT_NEAR(1000.0, static_cast<double>(result.completed), 300.0);
+  EXPECT_EQ(2u, result.latency_per_type.size());
+  EXPECT_EQ(result.completed, result.latency.count());
+}
+
+TEST(LoadGeneratorTest, singleThreadDrivesEveryModifierType)
+{
+  ValueModifierFactory factory;
+  LoadGeneratorConfig config;
+  config.rate_per_sec = 10000;
+  config.num_threads = 1;
+  config.duration_sec = 0.02;
+  config.mod_types = {IValueModifierFactory::ModifierType::SQUARE, IValueModifierFactory::ModifierType::LOG};
+
+  const LoadGeneratorResult result = runLoadGenerator(factory, config);
+
+  ASSERT_EQ(2u, result.latency_per_type.size());
+  for (const auto& entry : result.latency_per_type)
+  {
+    EXPECT_GT(entry.second.count(), 0u) << modifierTypeName(entry.first);
+  }
+  EXPECT_EQ(result.completed, result.latency.count());
+}
+
+TEST(LoadGeneratorTest, invalidConfigThrows)
+{
+  ValueModifierFactory factory;
+  LoadGeneratorConfig config;
+  config.duration_sec = 0.01;
+
+  config.num_threads = 0;
+  EXPECT_THROW(runLoadGenerator(factory, config), std::runtime_error);
+  config.num_threads = 1;
+
+  config.rate_per_sec = 0;
+  EXPECT_THROW(runLoadGenerator(factory, config), std::runtime_error);
+  config.rate_per_sec = std::nan("");
+  EXPECT_THROW(runLoadGenerator(factory, config), std::runtime_error);
+  config.rate_per_sec = 1000;
+
+  config.mod_types.clear();
+  EXPECT_THROW(runLoadGenerator(factory, config), std::runtime_error);
+}
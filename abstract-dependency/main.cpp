@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <memory>
@@ -42,6 +43,25 @@ class IValueModifier
 
   virtual void update(const MessageData& msg) = 0;
   virtual double generateVal() = 0;
+
+  /**
+   * @brief Generate values for a batch of messages.
+   *
+   * Equivalent to calling update() followed by generateVal() for each message in turn. Modifiers that can
+   * amortize work across a batch should override this.
+   *
+   * @param msgs The input messages.
+   * @param out Output buffer receiving one value per message.
+   * @param n The number of messages.
+   */
+  virtual void generateVals(const MessageData* msgs, double* out, const size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      update(msgs[i]);
+      out[i] = generateVal();
+    }
+  }
 };
 
 // <value_modifiers/square_value_modifier.h>
@@ -82,6 +102,535 @@ class LogValueModifier : public IValueModifier
   MessageData curr_data_;
 };
 
+// <value_modifiers/batched_square_value_modifier.h>
+class BatchedSquareValueModifier : public IValueModifier
+{
+ public:
+  void update(const MessageData& msg) override
+  {
+    curr_data_ = msg;
+  }
+
+  double generateVal() override
+  {
+    return curr_data_.get_val() * curr_data_.get_val();
+  }
+
+  void generateVals(const MessageData* msgs, double* out, const size_t n) override
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      out[i] = msgs[i].get_val() * msgs[i].get_val();
+    }
+    if (n > 0)
+    {
+      curr_data_ = msgs[n - 1];
+    }
+  }
+
+ private:
+  MessageData curr_data_;
+};
+
+// <value_modifiers/batched_log_value_modifier.h>
+class BatchedLogValueModifier : public IValueModifier
+{
+ public:
+  void update(const MessageData& msg) override
+  {
+    curr_data_ = msg;
+  }
+
+  double generateVal() override
+  {
+    return std::log(curr_data_.get_val());
+  }
+
+  void generateVals(const MessageData* msgs, double* out, const size_t n) override
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      out[i] = std::log(msgs[i].get_val());
+    }
+    if (n > 0)
+    {
+      curr_data_ = msgs[n - 1];
+    }
+  }
+
+ private:
+  MessageData curr_data_;
+};
+
+// <value_modifiers/table_log_value_modifier.h>
+
+/**
+ * @brief Approximate natural log: split x into 2^e * m with m in [1, 2) and interpolate log(m) from a table.
+ *
+ * Absolute error is below 1e-8. Non-positive, infinite and NaN inputs fall back to std::log.
+ */
+class TableLogValueModifier : public IValueModifier
+{
+ public:
+  TableLogValueModifier() : table_(kTableSize + 1)
+  {
+    for (size_t i = 0; i <= kTableSize; ++i)
+    {
+      table_[i] = std::log(1.0 + static_cast<double>(i) / kTableSize);
+    }
+  }
+
+  void update(const MessageData& msg) override
+  {
+    curr_data_ = msg;
+  }
+
+  double generateVal() override
+  {
+    return approxLog(curr_data_.get_val());
+  }
+
+  void generateVals(const MessageData* msgs, double* out, const size_t n) override
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      out[i] = approxLog(msgs[i].get_val());
+    }
+    if (n > 0)
+    {
+      curr_data_ = msgs[n - 1];
+    }
+  }
+
+ private:
+  static constexpr size_t kTableSize = 4096;
+
+  double approxLog(const double x) const
+  {
+    if (!(x > 0) || !std::isfinite(x))
+    {
+      return std::log(x);
+    }
+    int exponent = 0;
+    const double mantissa = 2.0 * std::frexp(x, &exponent);  // in [1, 2)
+    const double pos = (mantissa - 1.0) * kTableSize;
+    const auto idx = static_cast<size_t>(pos);
+    const double frac = pos - static_cast<double>(idx);
+    return (exponent - 1) * M_LN2 + table_[idx] + frac * (table_[idx + 1] - table_[idx]);
+  }
+
+  std::vector<double> table_;
+  MessageData curr_data_;
+};
+
+// <value_modifiers/expression_value_modifier.h>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+
+/**
+ * @brief A value modifier whose formula is given at runtime, e.g., "clamp(log(x*x)+3, 0, 42)".
+ *
+ * The expression is parsed once into register-based bytecode. Each register holds a block of kBlockSize
+ * values and each opcode is applied to the whole block, so dispatch cost is amortized across the batch.
+ *
+ * Supported syntax: the variable x, numeric literals, + - * /, unary minus, parentheses and the functions
+ * log, exp, sqrt, abs, min, max and clamp.
+ */
+class ExpressionValueModifier : public IValueModifier
+{
+ public:
+  static constexpr size_t kBlockSize = 256;
+
+  explicit ExpressionValueModifier(const std::string& expression)
+  {
+    Parser parser(expression, *this);
+    out_reg_ = parser.parse();
+
+    regs_.resize(num_regs_ * kBlockSize);
+    for (const auto& c : consts_)
+    {
+      std::fill_n(reg(c.first), kBlockSize, c.second);
+    }
+  }
+
+  void update(const MessageData& msg) override
+  {
+    curr_data_ = msg;
+  }
+
+  double generateVal() override
+  {
+    double out = 0;
+    const MessageData msg = curr_data_;
+    generateVals(&msg, &out, 1);
+    return out;
+  }
+
+  void generateVals(const MessageData* msgs, double* out, const size_t n) override
+  {
+    for (size_t begin = 0; begin < n; begin += kBlockSize)
+    {
+      const size_t len = std::min(kBlockSize, n - begin);
+
+      double* x = reg(kInputReg);
+      for (size_t i = 0; i < len; ++i)
+      {
+        x[i] = msgs[begin + i].get_val();
+      }
+
+      for (const auto& instr : code_)
+      {
+        execute(instr, len);
+      }
+
+      const double* res = reg(out_reg_);
+      std::copy(res, res + len, out + begin);
+    }
+
+    if (n > 0)
+    {
+      curr_data_ = msgs[n - 1];
+    }
+  }
+
+ private:
+  enum class OpCode : uint8_t
+  {
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    NEG,
+    LOG,
+    EXP,
+    SQRT,
+    ABS,
+    MIN,
+    MAX,
+    CLAMP
+  };
+
+  struct Instruction {
+    OpCode op;
+    uint16_t dst;
+    uint16_t a;
+    uint16_t b;
+    uint16_t c;
+  };
+
+  static constexpr uint16_t kInputReg = 0;
+
+  /**
+   * @brief Recursive descent parser emitting bytecode into the owning modifier.
+   */
+  class Parser
+  {
+   public:
+    Parser(const std::string& text, ExpressionValueModifier& owner) : text_(text), owner_(owner)
+    {
+    }
+
+    uint16_t parse()
+    {
+      const uint16_t r = parseExpr();
+      skipSpace();
+      if (pos_ != text_.size())
+      {
+        fail("unexpected trailing input");
+      }
+      return r;
+    }
+
+   private:
+    uint16_t parseExpr()
+    {
+      uint16_t lhs = parseTerm();
+      while (accept('+') || accept('-'))
+      {
+        const OpCode op = text_[pos_ - 1] == '+' ? OpCode::ADD : OpCode::SUB;
+        lhs = owner_.emit(op, lhs, parseTerm());
+      }
+      return lhs;
+    }
+
+    uint16_t parseTerm()
+    {
+      uint16_t lhs = parseUnary();
+      while (accept('*') || accept('/'))
+      {
+        const OpCode op = text_[pos_ - 1] == '*' ? OpCode::MUL : OpCode::DIV;
+        lhs = owner_.emit(op, lhs, parseUnary());
+      }
+      return lhs;
+    }
+
+    // every nesting level (unary minus, parentheses, function arguments) recurses through here
+    uint16_t parseUnary()
+    {
+      if (++depth_ > kMaxDepth)
+      {
+        fail("expression nested too deeply");
+      }
+      const uint16_t r = accept('-') ? owner_.emit(OpCode::NEG, parseUnary()) : parsePrimary();
+      --depth_;
+      return r;
+    }
+
+    uint16_t parsePrimary()
+    {
+      skipSpace();
+      if (accept('('))
+      {
+        const uint16_t r = parseExpr();
+        expect(')');
+        return r;
+      }
+      if (pos_ < text_.size() && (isDigit(text_[pos_]) || text_[pos_] == '.'))
+      {
+        return owner_.addConstant(parseNumber());
+      }
+
+      const std::string name = parseIdentifier();
+      if (name == "x")
+      {
+        return kInputReg;
+      }
+
+      std::vector<uint16_t> args;
+      expect('(');
+      args.push_back(parseExpr());
+      while (accept(','))
+      {
+        args.push_back(parseExpr());
+      }
+      expect(')');
+
+      if (args.size() == 1)
+      {
+        if (name == "log") return owner_.emit(OpCode::LOG, args[0]);
+        if (name == "exp") return owner_.emit(OpCode::EXP, args[0]);
+        if (name == "sqrt") return owner_.emit(OpCode::SQRT, args[0]);
+        if (name == "abs") return owner_.emit(OpCode::ABS, args[0]);
+      }
+      else if (args.size() == 2)
+      {
+        if (name == "min") return owner_.emit(OpCode::MIN, args[0], args[1]);
+        if (name == "max") return owner_.emit(OpCode::MAX, args[0], args[1]);
+      }
+      else if (args.size() == 3 && name == "clamp")
+      {
+        return owner_.emit(OpCode::CLAMP, args[0], args[1], args[2]);
+      }
+      fail("unknown function '" + name + "' with " + std::to_string(args.size()) + " argument(s)");
+      return 0;
+    }
+
+    /**
+     * @brief Scan a decimal literal (digits, optional fraction, optional exponent) independent of the locale.
+     */
+    double parseNumber()
+    {
+      const size_t start = pos_;
+      size_t num_digits = 0;
+      while (pos_ < text_.size() && isDigit(text_[pos_]))
+      {
+        ++pos_;
+        ++num_digits;
+      }
+      if (pos_ < text_.size() && text_[pos_] == '.')
+      {
+        ++pos_;
+        while (pos_ < text_.size() && isDigit(text_[pos_]))
+        {
+          ++pos_;
+          ++num_digits;
+        }
+      }
+      if (num_digits == 0)
+      {
+        fail("expected digits in number");
+      }
+      if (pos_ < text_.size() && (text_[pos_] == 'e' || text_[pos_] == 'E'))
+      {
+        ++pos_;
+        if (pos_ < text_.size() && (text_[pos_] == '+' || text_[pos_] == '-'))
+        {
+          ++pos_;
+        }
+        if (pos_ == text_.size() || !isDigit(text_[pos_]))
+        {
+          fail("expected digits in exponent");
+        }
+        while (pos_ < text_.size() && isDigit(text_[pos_]))
+        {
+          ++pos_;
+        }
+      }
+
+      double val = 0;
+      const char* first = text_.data() + start;
+      const char* last = text_.data() + pos_;
+      const auto result = std::from_chars(first, last, val);
+      if (result.ec == std::errc::result_out_of_range)
+      {
+        pos_ = start;
+        fail("number out of range");
+      }
+      if (result.ec != std::errc() || result.ptr != last)
+      {
+        pos_ = start;
+        fail("invalid number");
+      }
+      return val;
+    }
+
+    static bool isDigit(const char c)
+    {
+      return c >= '0' && c <= '9';
+    }
+
+    std::string parseIdentifier()
+    {
+      skipSpace();
+      const size_t start = pos_;
+      while (pos_ < text_.size() && std::isalpha(static_cast<unsigned char>(text_[pos_])))
+      {
+        ++pos_;
+      }
+      if (start == pos_)
+      {
+        fail("expected a number, 'x' or a function call");
+      }
+      return text_.substr(start, pos_ - start);
+    }
+
+    bool accept(const char c)
+    {
+      skipSpace();
+      if (pos_ < text_.size() && text_[pos_] == c)
+      {
+        ++pos_;
+        return true;
+      }
+      return false;
+    }
+
+    void expect(const char c)
+    {
+      if (!accept(c))
+      {
+        fail(std::string("expected '") + c + "'");
+      }
+    }
+
+    void skipSpace()
+    {
+      while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_])))
+      {
+        ++pos_;
+      }
+    }
+
+    [[noreturn]] void fail(const std::string& what) const
+    {
+      throw std::runtime_error("Invalid expression \"" + text_ + "\" at position " + std::to_string(pos_) + ": " +
+                               what);
+    }
+
+    static constexpr size_t kMaxDepth = 256;
+
+    const std::string& text_;
+    ExpressionValueModifier& owner_;
+    size_t pos_{0};
+    size_t depth_{0};
+  };
+
+  uint16_t allocRegister()
+  {
+    if (num_regs_ == UINT16_MAX)
+    {
+      throw std::runtime_error("Expression too large");
+    }
+    return num_regs_++;
+  }
+
+  uint16_t addConstant(const double val)
+  {
+    const uint16_t r = allocRegister();
+    consts_.emplace_back(r, val);
+    return r;
+  }
+
+  uint16_t emit(const OpCode op, const uint16_t a, const uint16_t b = 0, const uint16_t c = 0)
+  {
+    const uint16_t dst = allocRegister();
+    code_.push_back({op, dst, a, b, c});
+    return dst;
+  }
+
+  double* reg(const uint16_t r)
+  {
+    return regs_.data() + static_cast<size_t>(r) * kBlockSize;
+  }
+
+  void execute(const Instruction& instr, const size_t len)
+  {
+    double* __restrict dst = reg(instr.dst);
+    const double* __restrict a = reg(instr.a);
+    const double* __restrict b = reg(instr.b);
+    const double* __restrict c = reg(instr.c);
+
+    switch (instr.op)
+    {
+      case OpCode::ADD:
+        for (size_t i = 0; i < len; ++i) dst[i] = a[i] + b[i];
+        break;
+      case OpCode::SUB:
+        for (size_t i = 0; i < len; ++i) dst[i] = a[i] - b[i];
+        break;
+      case OpCode::MUL:
+        for (size_t i = 0; i < len; ++i) dst[i] = a[i] * b[i];
+        break;
+      case OpCode::DIV:
+        for (size_t i = 0; i < len; ++i) dst[i] = a[i] / b[i];
+        break;
+      case OpCode::NEG:
+        for (size_t i = 0; i < len; ++i) dst[i] = -a[i];
+        break;
+      case OpCode::LOG:
+        for (size_t i = 0; i < len; ++i) dst[i] = std::log(a[i]);
+        break;
+      case OpCode::EXP:
+        for (size_t i = 0; i < len; ++i) dst[i] = std::exp(a[i]);
+        break;
+      case OpCode::SQRT:
+        for (size_t i = 0; i < len; ++i) dst[i] = std::sqrt(a[i]);
+        break;
+      case OpCode::ABS:
+        for (size_t i = 0; i < len; ++i) dst[i] = std::fabs(a[i]);
+        break;
+      case OpCode::MIN:
+        for (size_t i = 0; i < len; ++i) dst[i] = std::min(a[i], b[i]);
+        break;
+      case OpCode::MAX:
+        for (size_t i = 0; i < len; ++i) dst[i] = std::max(a[i], b[i]);
+        break;
+      case OpCode::CLAMP:
+        for (size_t i = 0; i < len; ++i) dst[i] = std::min(std::max(a[i], b[i]), c[i]);
+        break;
+    }
+  }
+
+  std::vector<Instruction> code_;
+  std::vector<std::pair<uint16_t, double>> consts_;
+  std::vector<double> regs_;
+  uint16_t num_regs_{kInputReg + 1};
+  uint16_t out_reg_{kInputReg};
+  MessageData curr_data_;
+};
+
 // What if I want to easily experiment with differnt value modifiers?
 // e.g., SquareValueModifier, LogValueModifier, LinearValueModifier, etc.
 
@@ -104,8 +653,29 @@ class IValueModifierFactory
   virtual ~IValueModifierFactory() = default;
 
   virtual std::unique_ptr<IValueModifier> makeValueModifier(const ModifierType& mod_type) = 0;
+
+  /**
+   * @brief Create a modifier whose formula is given as a string, e.g., "clamp(log(x*x)+3, 0, 42)".
+   */
+  virtual std::unique_ptr<IValueModifier> makeExpressionValueModifier(const std::string& expression) = 0;
 };
 
+/**
+ * @brief Human-readable name of a modifier type, used when reporting per-type results.
+ */
+const char* modifierTypeName(const IValueModifierFactory::ModifierType mod_type)
+{
+  switch (mod_type)
+  {
+    case IValueModifierFactory::ModifierType::SQUARE:
+      return "SQUARE";
+    case IValueModifierFactory::ModifierType::LOG:
+      return "LOG";
+    default:
+      return "UNKNOWN";
+  }
+}
+
 // value_modifier_factory.h
 
 // #include <value_modifier_lib/log_modifier.h>
@@ -128,47 +698,2744 @@ class ValueModifierFactory : public IValueModifierFactory
         throw std::runtime_error("Unknown value modifier encountered");
     }
   }
+
+  std::unique_ptr<IValueModifier> makeExpressionValueModifier(const std::string& expression) override
+  {
+    return std::make_unique<ExpressionValueModifier>(expression);
+  }
 };
 
-/*************************************************************************
- * Solver
- ************************************************************************/
+// autotuning_value_modifier_factory.h
 
-// #include <value_modifier/value_modifier_interface.h>
+// #include <value_modifier_lib/batched_log_modifier.h>
+// #include <value_modifier_lib/batched_square_modifier.h>
+// #include <value_modifier_lib/expression_modifier.h>
+// #include <value_modifier_lib/log_modifier.h>
+// #include <value_modifier_lib/square_modifier.h>
+// #include <value_modifier_lib/table_log_modifier.h>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <map>
+#include <sstream>
 
-class Solver
+/**
+ * @brief A factory that picks, per ModifierType, the fastest implementation on the local CPU.
+ *
+ * Each type has several candidate implementations. On first use every candidate whose output stays within
+ * `tolerance` (relative to the reference implementation, i.e., the one ValueModifierFactory uses) is timed on
+ * both the per-message path (updateDataCb()/solve()) and the batch path (solveBatch()), and the fastest on each
+ * is chosen; makeValueModifier() returns the choice for the Usage the factory was constructed with. The choices
+ * are written to `profile_path` together with the CPU model, the tolerance and the candidate set; later runs on
+ * the same CPU model and candidate set, with a tolerance no tighter than the cached one, load them instead of
+ * re-benchmarking.
+ */
+class AutotuningValueModifierFactory : public IValueModifierFactory
 {
  public:
-  explicit Solver(const double clipping_limit, std::unique_ptr<IValueModifier> value_modifier_ptr)
-    : clipping_limit_(clipping_limit), value_modifier_ptr_(std::move(value_modifier_ptr))
-  {
-    assert(value_modifier_ptr_);
-  }
+  struct Candidate {
+    std::string name;
+    std::function<std::unique_ptr<IValueModifier>()> make;
+  };
 
   /**
-   * @brief Callback function called by another component.
-   *
-   * @param msg The message containing the updated data.
+   * @brief How the Solvers built from this factory's modifiers will be driven.
    */
-  void updateDataCb(const MessageData& msg)
+  enum class Usage
   {
-    curr_data_ = msg;
-    value_modifier_ptr_->update(msg);
-  }
+    PER_MESSAGE,
+    BATCH
+  };
 
-  double solve()
+  static const char* usageName(const Usage usage)
   {
-    // limit the value to the clipping_limit
-    const double val = value_modifier_ptr_->generateVal();
-    return std::min(clipping_limit_, val);
+    return usage == Usage::BATCH ? "batch" : "per-message";
   }
 
- private:
-  double clipping_limit_{0};
-  MessageData curr_data_;
+  /**
+   * @brief Candidate implementations of a modifier type; the first is the reference implementation.
+   */
+  static std::vector<Candidate> candidates(const ModifierType mod_type)
+  {
+    switch (mod_type)
+    {
+      case ModifierType::SQUARE:
+        return {{"scalar", [] { return std::make_unique<SquareValueModifier>(); }},
+                {"batched", [] { return std::make_unique<BatchedSquareValueModifier>(); }},
+                {"expression", [] { return std::make_unique<ExpressionValueModifier>("x*x"); }}};
+      case ModifierType::LOG:
+        return {{"scalar", [] { return std::make_unique<LogValueModifier>(); }},
+                {"batched", [] { return std::make_unique<BatchedLogValueModifier>(); }},
+                {"table", [] { return std::make_unique<TableLogValueModifier>(); }},
+                {"expression", [] { return std::make_unique<ExpressionValueModifier>("log(x)"); }}};
+      default:
+        throw std::runtime_error("Unknown value modifier encountered");
+    }
+  }
+
+  AutotuningValueModifierFactory(const std::string& profile_path,
+                                 const double tolerance,
+                                 const Usage usage = Usage::PER_MESSAGE)
+    : profile_path_(profile_path), tolerance_(tolerance), usage_(usage), cpu_model_(readCpuModel())
+  {
+    if (!(tolerance_ >= 0) || !std::isfinite(tolerance_))
+    {
+      throw std::runtime_error("Autotuning tolerance must be a finite number no less than zero");
+    }
+    loaded_from_profile_ = loadProfile();
+    if (!loaded_from_profile_)
+    {
+      for (const auto mod_type : {ModifierType::SQUARE, ModifierType::LOG})
+      {
+        for (const auto usage : {Usage::PER_MESSAGE, Usage::BATCH})
+        {
+          selected_[{mod_type, usage}] = benchmark(mod_type, usage);
+        }
+      }
+      saveProfile();
+    }
+  }
+
+  std::unique_ptr<IValueModifier> makeValueModifier(const ModifierType& mod_type) override
+  {
+    const std::string& name = selectedImplementation(mod_type);
+    for (auto& candidate : candidates(mod_type))
+    {
+      if (candidate.name == name)
+      {
+        return candidate.make();
+      }
+    }
+    throw std::runtime_error("Unknown value modifier encountered");
+  }
+
+  std::unique_ptr<IValueModifier> makeExpressionValueModifier(const std::string& expression) override
+  {
+    return std::make_unique<ExpressionValueModifier>(expression);
+  }
+
+  const std::string& selectedImplementation(const ModifierType mod_type) const
+  {
+    return selectedImplementation(mod_type, usage_);
+  }
+
+  const std::string& selectedImplementation(const ModifierType mod_type, const Usage usage) const
+  {
+    const auto it = selected_.find({mod_type, usage});
+    if (it == selected_.end())
+    {
+      throw std::runtime_error("Unknown value modifier encountered");
+    }
+    return it->second;
+  }
+
+  bool loadedFromProfile() const
+  {
+    return loaded_from_profile_;
+  }
+
+ private:
+  static std::string readCpuModel()
+  {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line))
+    {
+      if (line.rfind("model name", 0) == 0)
+      {
+        const size_t colon = line.find(':');
+        const size_t begin = colon == std::string::npos ? std::string::npos : line.find_first_not_of(" \t", colon + 1);
+        return begin == std::string::npos ? "unknown" : line.substr(begin);
+      }
+    }
+    return "unknown";
+  }
+
+  static bool parseModifierType(const std::string& name, ModifierType& mod_type)
+  {
+    for (const auto candidate : {ModifierType::SQUARE, ModifierType::LOG})
+    {
+      if (name == modifierTypeName(candidate))
+      {
+        mod_type = candidate;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static bool parseUsage(const std::string& name, Usage& usage)
+  {
+    for (const auto candidate : {Usage::PER_MESSAGE, Usage::BATCH})
+    {
+      if (name == usageName(candidate))
+      {
+        usage = candidate;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Names of all candidates per type, so that a profile is invalidated when the candidate set changes.
+   */
+  static std::string candidateSignature()
+  {
+    std::string signature;
+    for (const auto mod_type : {ModifierType::SQUARE, ModifierType::LOG})
+    {
+      signature += signature.empty() ? "" : ";";
+      signature += std::string(modifierTypeName(mod_type)) + "=";
+      const auto all = candidates(mod_type);
+      for (size_t i = 0; i < all.size(); ++i)
+      {
+        signature += (i > 0 ? "," : "") + all[i].name;
+      }
+    }
+    return signature;
+  }
+
+  /**
+   * @brief Load cached choices.
+   *
+   * Fails if the file is missing or malformed, was written on a different CPU model or for a different candidate
+   * set, or picked its winners under a looser tolerance than the one configured now.
+   */
+  bool loadProfile()
+  {
+    std::ifstream in(profile_path_);
+    in.imbue(std::locale::classic());
+    std::string line;
+    if (!std::getline(in, line) || line != "cpu " + cpu_model_)
+    {
+      return false;
+    }
+
+    double cached_tolerance = 0;
+    std::string key;
+    if (!std::getline(in, line))
+    {
+      return false;
+    }
+    std::istringstream tolerance_fields(line);
+    tolerance_fields.imbue(std::locale::classic());
+    if (!(tolerance_fields >> key >> cached_tolerance) || key != "tolerance" || cached_tolerance > tolerance_)
+    {
+      return false;
+    }
+    if (!std::getline(in, line) || line != "candidates " + candidateSignature())
+    {
+      return false;
+    }
+
+    std::map<std::pair<ModifierType, Usage>, std::string> selected;
+    while (std::getline(in, line))
+    {
+      std::istringstream fields(line);
+      std::string type_name;
+      std::string usage_name;
+      std::string impl_name;
+      ModifierType mod_type;
+      Usage usage;
+      if (!(fields >> type_name >> usage_name >> impl_name) || !parseModifierType(type_name, mod_type) ||
+          !parseUsage(usage_name, usage))
+      {
+        return false;
+      }
+      const auto all = candidates(mod_type);
+      if (std::none_of(all.begin(), all.end(), [&](const Candidate& c) { return c.name == impl_name; }))
+      {
+        return false;
+      }
+      selected[{mod_type, usage}] = impl_name;
+    }
+    if (selected.size() != 4)
+    {
+      return false;
+    }
+    selected_ = std::move(selected);
+    return true;
+  }
+
+  void saveProfile() const
+  {
+    std::ofstream out(profile_path_);
+    out.imbue(std::locale::classic());
+    out << "cpu " << cpu_model_ << '\n';
+    out << "tolerance " << std::setprecision(std::numeric_limits<double>::max_digits10) << tolerance_ << '\n';
+    out << "candidates " << candidateSignature() << '\n';
+    for (const auto& entry : selected_)
+    {
+      out << modifierTypeName(entry.first.first) << ' ' << usageName(entry.first.second) << ' ' << entry.second
+          << '\n';
+    }
+    if (!out)
+    {
+      std::cerr << "Failed to write autotuning profile " << profile_path_ << std::endl;
+    }
+  }
+
+  /**
+   * @brief Name of the fastest candidate within tolerance when driven the way `usage` describes.
+   */
+  std::string benchmark(const ModifierType mod_type, const Usage usage) const
+  {
+    const size_t n = 4096;
+    const size_t reps = 200;
+
+    // log-spaced positive inputs so that every candidate sees a realistic range
+    std::vector<MessageData> msgs;
+    for (size_t i = 0; i < n; ++i)
+    {
+      msgs.emplace_back(std::pow(10.0, -3.0 + 6.0 * static_cast<double>(i) / n));
+    }
+
+    const std::vector<Candidate> all = candidates(mod_type);
+    std::vector<double> reference(n);
+    all.front().make()->generateVals(msgs.data(), reference.data(), n);
+
+    std::string best_name = all.front().name;
+    double best_seconds = std::numeric_limits<double>::infinity();
+    std::vector<double> out(n);
+    const auto run = [&](IValueModifier& modifier) {
+      if (usage == Usage::BATCH)
+      {
+        modifier.generateVals(msgs.data(), out.data(), n);
+        return;
+      }
+      for (size_t i = 0; i < n; ++i)
+      {
+        modifier.update(msgs[i]);
+        out[i] = modifier.generateVal();
+      }
+    };
+    for (const auto& candidate : all)
+    {
+      std::unique_ptr<IValueModifier> modifier = candidate.make();
+
+      run(*modifier);
+      bool accurate = true;
+      for (size_t i = 0; i < n && accurate; ++i)
+      {
+        accurate = std::fabs(out[i] - reference[i]) <= tolerance_ * std::max(1.0, std::fabs(reference[i]));
+      }
+      if (!accurate)
+      {
+        continue;
+      }
+
+      // best of several repetitions filters out interference from the rest of the system
+      double seconds = std::numeric_limits<double>::infinity();
+      for (size_t r = 0; r < reps; ++r)
+      {
+        const auto start = std::chrono::steady_clock::now();
+        run(*modifier);
+        seconds = std::min(seconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+      }
+      if (seconds < best_seconds)
+      {
+        best_seconds = seconds;
+        best_name = candidate.name;
+      }
+    }
+    return best_name;
+  }
+
+  std::string profile_path_;
+  double tolerance_{0};
+  Usage usage_{Usage::PER_MESSAGE};
+  std::string cpu_model_;
+  bool loaded_from_profile_{false};
+  std::map<std::pair<ModifierType, Usage>, std::string> selected_;
+};
+
+/*************************************************************************
+ * Solver
+ ************************************************************************/
+
+// #include <value_modifier/value_modifier_interface.h>
+
+class Solver
+{
+ public:
+  explicit Solver(const double clipping_limit, std::unique_ptr<IValueModifier> value_modifier_ptr)
+    : clipping_limit_(clipping_limit), value_modifier_ptr_(std::move(value_modifier_ptr))
+  {
+    assert(value_modifier_ptr_);
+  }
+
+  /**
+   * @brief Callback function called by another component.
+   *
+   * @param msg The message containing the updated data.
+   */
+  void updateDataCb(const MessageData& msg)
+  {
+    curr_data_ = msg;
+    value_modifier_ptr_->update(msg);
+  }
+
+  double solve()
+  {
+    // limit the value to the clipping_limit
+    const double val = value_modifier_ptr_->generateVal();
+    return std::min(clipping_limit_, val);
+  }
+
+  /**
+   * @brief Solve for a batch of messages, as if updateDataCb() and solve() were called for each in turn.
+   *
+   * @param msgs The input messages.
+   * @param out Output buffer receiving one clipped value per message.
+   * @param n The number of messages.
+   */
+  void solveBatch(const MessageData* msgs, double* out, const size_t n)
+  {
+    if (n == 0)
+    {
+      return;
+    }
+    value_modifier_ptr_->generateVals(msgs, out, n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      out[i] = std::min(clipping_limit_, out[i]);
+    }
+    curr_data_ = msgs[n - 1];
+  }
+
+ private:
+  double clipping_limit_{0};
+  MessageData curr_data_;
   std::unique_ptr<IValueModifier> value_modifier_ptr_{nullptr};
 };
 
+// <solver/ensemble_solver.h>
+// #include <value_modifier_factory_interface.h>
+
+/**
+ * @brief Evaluates each message against several modifier types in one pass over the input.
+ *
+ * Results are written row-major: row i holds the clipped output of every modifier, in the order the types
+ * were given, for message i. Input is processed in tiles of kTileSize messages so that each tile stays in
+ * cache while every modifier runs over it, rather than re-streaming the whole input once per modifier.
+ */
+class EnsembleSolver
+{
+ public:
+  using ModifierType = IValueModifierFactory::ModifierType;
+
+  static constexpr size_t kTileSize = 256;
+
+  EnsembleSolver(const double clipping_limit,
+                 IValueModifierFactory& value_modifier_factory,
+                 const std::vector<ModifierType>& mod_types)
+    : clipping_limit_(clipping_limit), mod_types_(mod_types), tile_out_(kTileSize)
+  {
+    if (mod_types_.empty())
+    {
+      throw std::runtime_error("EnsembleSolver needs at least one modifier type");
+    }
+    value_modifier_ptrs_.reserve(mod_types_.size());
+    for (const auto mod_type : mod_types_)
+    {
+      value_modifier_ptrs_.push_back(value_modifier_factory.makeValueModifier(mod_type));
+    }
+  }
+
+  size_t numModifiers() const
+  {
+    return value_modifier_ptrs_.size();
+  }
+
+  const std::vector<ModifierType>& modifierTypes() const
+  {
+    return mod_types_;
+  }
+
+  /**
+   * @brief Solve a batch of messages against every modifier.
+   *
+   * @param msgs The input messages.
+   * @param out Row-major output of n * numModifiers() clipped values.
+   * @param n The number of messages.
+   */
+  void solveBatch(const MessageData* msgs, double* out, const size_t n)
+  {
+    const size_t num_mods = numModifiers();
+    for (size_t begin = 0; begin < n; begin += kTileSize)
+    {
+      const size_t len = std::min(kTileSize, n - begin);
+      for (size_t m = 0; m < num_mods; ++m)
+      {
+        value_modifier_ptrs_[m]->generateVals(msgs + begin, tile_out_.data(), len);
+
+        double* row = out + begin * num_mods + m;
+        for (size_t i = 0; i < len; ++i)
+        {
+          row[i * num_mods] = std::min(clipping_limit_, tile_out_[i]);
+        }
+      }
+    }
+  }
+
+ private:
+  double clipping_limit_{0};
+  std::vector<ModifierType> mod_types_;
+  std::vector<std::unique_ptr<IValueModifier>> value_modifier_ptrs_;
+  std::vector<double> tile_out_;
+};
+
+/*************************************************************************
+ * Aggregation
+ ************************************************************************/
+
+// <aggregation/kll_sketch.h>
+#include <limits>
+
+/**
+ * @brief Mergeable KLL quantile sketch over doubles.
+ *
+ * Items live in a stack of compactors; level h holds items of weight 2^h. When a level fills up it is sorted
+ * and every other item is promoted to the next level, so memory stays O(k log(n/k)) while rank error stays
+ * around 1.7/k. Sketches from different workers or windows can be merged.
+ */
+class KllSketch
+{
+ public:
+  explicit KllSketch(const uint32_t k = 200) : k_(k), levels_(1)
+  {
+    assert(k_ >= 8);
+  }
+
+  void update(const double value)
+  {
+    levels_[0].push_back(value);
+    ++n_;
+    if (levels_[0].size() >= capacity(0))
+    {
+      compress();
+    }
+  }
+
+  void merge(const KllSketch& other)
+  {
+    if (levels_.size() < other.levels_.size())
+    {
+      levels_.resize(other.levels_.size());
+    }
+    for (size_t h = 0; h < other.levels_.size(); ++h)
+    {
+      levels_[h].insert(levels_[h].end(), other.levels_[h].begin(), other.levels_[h].end());
+    }
+    n_ += other.n_;
+    compress();
+  }
+
+  uint64_t count() const
+  {
+    return n_;
+  }
+
+  /**
+   * @brief Approximate value at normalized rank q in [0, 1]; NaN if the sketch is empty.
+   */
+  double quantile(const double q) const
+  {
+    if (n_ == 0)
+    {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    std::vector<std::pair<double, uint64_t>> weighted;
+    for (size_t h = 0; h < levels_.size(); ++h)
+    {
+      for (const double v : levels_[h])
+      {
+        weighted.emplace_back(v, uint64_t{1} << h);
+      }
+    }
+    std::sort(weighted.begin(), weighted.end());
+
+    const double target = std::min(std::max(q, 0.0), 1.0) * static_cast<double>(n_);
+    uint64_t cumulative = 0;
+    for (const auto& item : weighted)
+    {
+      cumulative += item.second;
+      if (static_cast<double>(cumulative) >= target)
+      {
+        return item.first;
+      }
+    }
+    return weighted.back().first;
+  }
+
+ private:
+  size_t capacity(const size_t level) const
+  {
+    const double depth = static_cast<double>(levels_.size() - 1 - level);
+    return std::max<size_t>(2, static_cast<size_t>(std::ceil(k_ * std::pow(2.0 / 3.0, depth))));
+  }
+
+  void compress()
+  {
+    for (size_t h = 0; h < levels_.size(); ++h)
+    {
+      if (levels_[h].size() < capacity(h))
+      {
+        continue;
+      }
+      if (h + 1 == levels_.size())
+      {
+        levels_.emplace_back();
+      }
+
+      std::vector<double>& level = levels_[h];
+      std::sort(level.begin(), level.end());
+
+      // promote every other item of an even-sized prefix; an odd item out stays behind
+      const size_t paired = level.size() & ~size_t{1};
+      const size_t offset = nextCoin();
+      for (size_t i = offset; i < paired; i += 2)
+      {
+        levels_[h + 1].push_back(level[i]);
+      }
+      level.erase(level.begin(), level.begin() + static_cast<std::ptrdiff_t>(paired));
+    }
+  }
+
+  size_t nextCoin()
+  {
+    // xorshift64; compaction only needs an unbiased bit, not a quality generator
+    rng_state_ ^= rng_state_ << 13;
+    rng_state_ ^= rng_state_ >> 7;
+    rng_state_ ^= rng_state_ << 17;
+    return static_cast<size_t>(rng_state_ & 1);
+  }
+
+  uint32_t k_;
+  uint64_t n_{0};
+  uint64_t rng_state_{0x9E3779B97F4A7C15ull};
+  std::vector<std::vector<double>> levels_;
+};
+
+// <aggregation/output_summary.h>
+
+/**
+ * @brief Mergeable distribution summary of Solver outputs: count, clipped count, min/max/mean and quantiles.
+ */
+struct OutputSummary {
+  uint64_t count{0};
+  uint64_t clipped_count{0};
+  double min{std::numeric_limits<double>::infinity()};
+  double max{-std::numeric_limits<double>::infinity()};
+  double sum{0};
+  KllSketch quantiles;
+
+  void add(const double value, const bool clipped)
+  {
+    ++count;
+    clipped_count += clipped ? 1 : 0;
+    min = std::min(min, value);
+    max = std::max(max, value);
+    sum += value;
+    quantiles.update(value);
+  }
+
+  void merge(const OutputSummary& other)
+  {
+    count += other.count;
+    clipped_count += other.clipped_count;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+    sum += other.sum;
+    quantiles.merge(other.quantiles);
+  }
+
+  double mean() const
+  {
+    return count > 0 ? sum / static_cast<double>(count) : std::numeric_limits<double>::quiet_NaN();
+  }
+};
+
+// <aggregation/output_aggregator.h>
+
+/**
+ * @brief Optional stage after Solver::solve() that summarizes a stream's outputs per window.
+ *
+ * Windows are a fixed number of consecutive outputs. Each completed window is kept as an OutputSummary until
+ * collected with takeCompletedWindows(); the running total across all windows is available via total().
+ * Keep one aggregator per stream and merge summaries across workers.
+ */
+class OutputAggregator
+{
+ public:
+  OutputAggregator(const double clipping_limit, const uint64_t window_size)
+    : clipping_limit_(clipping_limit), window_size_(window_size)
+  {
+    assert(window_size_ > 0);
+  }
+
+  void add(const double value)
+  {
+    const bool clipped = value >= clipping_limit_;
+    window_.add(value, clipped);
+    total_.add(value, clipped);
+    if (window_.count == window_size_)
+    {
+      completed_windows_.push_back(std::move(window_));
+      window_ = OutputSummary();
+    }
+  }
+
+  void add(const double* values, const size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      add(values[i]);
+    }
+  }
+
+  std::vector<OutputSummary> takeCompletedWindows()
+  {
+    std::vector<OutputSummary> windows;
+    windows.swap(completed_windows_);
+    return windows;
+  }
+
+  const OutputSummary& currentWindow() const
+  {
+    return window_;
+  }
+
+  const OutputSummary& total() const
+  {
+    return total_;
+  }
+
+ private:
+  double clipping_limit_{0};
+  uint64_t window_size_{0};
+  OutputSummary window_;
+  OutputSummary total_;
+  std::vector<OutputSummary> completed_windows_;
+};
+
+/*************************************************************************
+ * Compression
+ ************************************************************************/
+
+// <storage/bit_stream.h>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+/**
+ * @brief Appends MSB-first bit fields to a caller-sized buffer of 64-bit words.
+ *
+ * The buffer must be large enough for everything written (codecs bound their worst case per value), which
+ * keeps the per-word store free of capacity checks and reallocation.
+ */
+class BitWriter
+{
+ public:
+  BitWriter() = default;
+
+  BitWriter(uint64_t* words, const size_t capacity) : words_(words), capacity_(capacity)
+  {
+  }
+
+  /**
+   * @brief Append the low `n` bits of `bits`, 1 <= n <= 64.
+   */
+  void write(uint64_t bits, const unsigned n)
+  {
+    assert(n >= 1 && n <= 64);
+    if (n < 64)
+    {
+      bits &= (uint64_t{1} << n) - 1;
+    }
+    const unsigned space = 64 - fill_;
+    if (n < space)
+    {
+      acc_ |= bits << (space - n);
+      fill_ += n;
+      return;
+    }
+    const unsigned rest = n - space;
+    assert(num_words_ < capacity_);
+    words_[num_words_++] = acc_ | (bits >> rest);
+    acc_ = rest > 0 ? bits << (64 - rest) : 0;
+    fill_ = rest;
+  }
+
+  /**
+   * @brief Flush any partially filled word.
+   *
+   * @return The number of words written.
+   */
+  size_t finish()
+  {
+    if (fill_ > 0)
+    {
+      assert(num_words_ < capacity_);
+      words_[num_words_++] = acc_;
+      acc_ = 0;
+      fill_ = 0;
+    }
+    return num_words_;
+  }
+
+ private:
+  uint64_t* words_{nullptr};
+  size_t capacity_{0};
+  size_t num_words_{0};
+  uint64_t acc_{0};
+  unsigned fill_{0};
+};
+
+/**
+ * @brief Reads bit fields written by BitWriter, throwing if a read runs past the end of the buffer.
+ */
+class BitReader
+{
+ public:
+  BitReader(const uint64_t* words, const size_t num_words) : words_(words), num_bits_(num_words * 64)
+  {
+  }
+
+  /**
+   * @brief Read the next `n` bits, 1 <= n <= 64.
+   */
+  uint64_t read(const unsigned n)
+  {
+    assert(n >= 1 && n <= 64);
+    if (pos_ + n > num_bits_)
+    {
+      throw std::runtime_error("Compressed block is truncated");
+    }
+    const size_t idx = pos_ >> 6;
+    const unsigned offset = static_cast<unsigned>(pos_ & 63);
+    pos_ += n;
+
+    const uint64_t head = words_[idx] << offset;
+    if (offset + n <= 64)
+    {
+      return head >> (64 - n);
+    }
+    const unsigned rest = offset + n - 64;
+    return (head >> (64 - n)) | (words_[idx + 1] >> (64 - rest));
+  }
+
+ private:
+  const uint64_t* words_;
+  size_t num_bits_;
+  size_t pos_{0};
+};
+
+// <storage/gorilla_codecs.h>
+
+/**
+ * @brief Gorilla XOR encoding of doubles.
+ *
+ * Each value is XORed with its predecessor. An identical value costs one bit; otherwise only the meaningful
+ * bits between the leading and trailing zeros are stored, reusing the previous value's window when they fit.
+ */
+struct XorCodec {
+  using value_type = double;
+
+  // worst case: 2 control bits, 5 + 6 bits of window, 64 meaningful bits
+  static constexpr size_t kMaxBitsPerValue = 77;
+
+  class Encoder
+  {
+   public:
+    void encode(BitWriter& writer, const double value)
+    {
+      uint64_t bits = 0;
+      std::memcpy(&bits, &value, sizeof(bits));
+      if (first_)
+      {
+        writer.write(bits, 64);
+        prev_ = bits;
+        first_ = false;
+        return;
+      }
+
+      const uint64_t x = bits ^ prev_;
+      prev_ = bits;
+      if (x == 0)
+      {
+        writer.write(0, 1);
+        return;
+      }
+
+      const unsigned lead = std::min(31u, static_cast<unsigned>(__builtin_clzll(x)));
+      const unsigned trail = static_cast<unsigned>(__builtin_ctzll(x));
+      // control bits are merged with the payload into a single write whenever they fit in 64 bits
+      if (has_window_ && lead >= lead_ && trail >= trail_)
+      {
+        const unsigned width = 64 - lead_ - trail_;
+        if (width <= 62)
+        {
+          writer.write((uint64_t{0b10} << width) | (x >> trail_), width + 2);
+        }
+        else
+        {
+          writer.write(0b10, 2);
+          writer.write(x >> trail_, width);
+        }
+        return;
+      }
+
+      const unsigned meaningful = 64 - lead - trail;
+      const uint64_t header = (uint64_t{0b11} << 11) | (uint64_t{lead} << 6) | (meaningful - 1);
+      if (meaningful <= 51)
+      {
+        writer.write((header << meaningful) | (x >> trail), meaningful + 13);
+      }
+      else
+      {
+        writer.write(header, 13);
+        writer.write(x >> trail, meaningful);
+      }
+      lead_ = lead;
+      trail_ = trail;
+      has_window_ = true;
+    }
+
+   private:
+    uint64_t prev_{0};
+    unsigned lead_{0};
+    unsigned trail_{0};
+    bool first_{true};
+    bool has_window_{false};
+  };
+
+  class Decoder
+  {
+   public:
+    double decode(BitReader& reader)
+    {
+      if (first_)
+      {
+        prev_ = reader.read(64);
+        first_ = false;
+      }
+      else if (reader.read(1) != 0)
+      {
+        if (reader.read(1) != 0)
+        {
+          lead_ = static_cast<unsigned>(reader.read(5));
+          const unsigned meaningful = static_cast<unsigned>(reader.read(6)) + 1;
+          trail_ = 64 - lead_ - meaningful;
+        }
+        prev_ ^= reader.read(64 - lead_ - trail_) << trail_;
+      }
+
+      double value = 0;
+      std::memcpy(&value, &prev_, sizeof(value));
+      return value;
+    }
+
+   private:
+    uint64_t prev_{0};
+    unsigned lead_{0};
+    unsigned trail_{0};
+    bool first_{true};
+  };
+};
+
+/**
+ * @brief Delta-of-delta encoding of int64 values such as timestamps and counters.
+ *
+ * Regularly spaced values have a delta-of-delta of zero and cost one bit each; small irregularities fall in
+ * 7, 9 or 12 bit buckets and anything else is stored in full.
+ */
+struct DeltaOfDeltaCodec {
+  using value_type = int64_t;
+
+  // worst case: 4 control bits and a full 64-bit delta-of-delta
+  static constexpr size_t kMaxBitsPerValue = 68;
+
+  class Encoder
+  {
+   public:
+    void encode(BitWriter& writer, const int64_t value)
+    {
+      const auto bits = static_cast<uint64_t>(value);
+      if (first_)
+      {
+        writer.write(bits, 64);
+        prev_ = bits;
+        first_ = false;
+        return;
+      }
+
+      // unsigned arithmetic wraps instead of overflowing on extreme inputs
+      const uint64_t delta = bits - prev_;
+      const auto dod = static_cast<int64_t>(delta - prev_delta_);
+      const uint64_t zigzag = (static_cast<uint64_t>(dod) << 1) ^ static_cast<uint64_t>(dod >> 63);
+      prev_ = bits;
+      prev_delta_ = delta;
+
+      if (zigzag == 0)
+      {
+        writer.write(0b0, 1);
+      }
+      else if (zigzag < (uint64_t{1} << 7))
+      {
+        writer.write((uint64_t{0b10} << 7) | zigzag, 9);
+      }
+      else if (zigzag < (uint64_t{1} << 9))
+      {
+        writer.write((uint64_t{0b110} << 9) | zigzag, 12);
+      }
+      else if (zigzag < (uint64_t{1} << 12))
+      {
+        writer.write((uint64_t{0b1110} << 12) | zigzag, 16);
+      }
+      else
+      {
+        writer.write(0b1111, 4);
+        writer.write(zigzag, 64);
+      }
+    }
+
+   private:
+    uint64_t prev_{0};
+    uint64_t prev_delta_{0};
+    bool first_{true};
+  };
+
+  class Decoder
+  {
+   public:
+    int64_t decode(BitReader& reader)
+    {
+      if (first_)
+      {
+        prev_ = reader.read(64);
+        first_ = false;
+        return static_cast<int64_t>(prev_);
+      }
+
+      unsigned width = 0;
+      if (reader.read(1) != 0)
+      {
+        if (reader.read(1) == 0)
+        {
+          width = 7;
+        }
+        else if (reader.read(1) == 0)
+        {
+          width = 9;
+        }
+        else
+        {
+          width = reader.read(1) == 0 ? 12 : 64;
+        }
+      }
+
+      const uint64_t zigzag = width > 0 ? reader.read(width) : 0;
+      const uint64_t dod = (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+      prev_delta_ += dod;
+      prev_ += prev_delta_;
+      return static_cast<int64_t>(prev_);
+    }
+
+   private:
+    uint64_t prev_{0};
+    uint64_t prev_delta_{0};
+    bool first_{true};
+  };
+};
+
+// <storage/compressed_column.h>
+
+/**
+ * @brief Append-only column of values compressed in independently decodable blocks.
+ *
+ * Blocks hold up to kBlockSize values each, so a Reader only ever holds one block's decoder state and can
+ * stream values into a caller-provided buffer without materializing the column.
+ */
+template <typename Codec>
+class CompressedColumn
+{
+ public:
+  using value_type = typename Codec::value_type;
+
+  static constexpr uint32_t kBlockSize = 4096;
+
+  struct Block {
+    uint32_t count{0};
+    std::vector<uint64_t> words;
+  };
+
+  class Reader
+  {
+   public:
+    explicit Reader(const CompressedColumn& column) : column_(column)
+    {
+      if (column_.writing_)
+      {
+        throw std::runtime_error("Compressed column must be finish()ed before it is read");
+      }
+    }
+
+    /**
+     * @brief Decode up to `max` values into `out`; returns the number decoded, 0 at the end of the column.
+     */
+    size_t read(value_type* out, const size_t max)
+    {
+      size_t n = 0;
+      while (n < max && block_idx_ < column_.blocks_.size())
+      {
+        const Block& block = column_.blocks_[block_idx_];
+        if (pos_in_block_ == 0)
+        {
+          bit_reader_ = BitReader(block.words.data(), block.words.size());
+          decoder_ = typename Codec::Decoder();
+        }
+
+        const size_t take = std::min<size_t>(max - n, block.count - pos_in_block_);
+        for (size_t i = 0; i < take; ++i)
+        {
+          out[n++] = decoder_.decode(bit_reader_);
+        }
+        pos_in_block_ += static_cast<uint32_t>(take);
+        if (pos_in_block_ == block.count)
+        {
+          ++block_idx_;
+          pos_in_block_ = 0;
+        }
+      }
+      return n;
+    }
+
+   private:
+    const CompressedColumn& column_;
+    size_t block_idx_{0};
+    uint32_t pos_in_block_{0};
+    BitReader bit_reader_{nullptr, 0};
+    typename Codec::Decoder decoder_;
+  };
+
+  CompressedColumn() = default;
+  CompressedColumn(const CompressedColumn&) = delete;
+  CompressedColumn& operator=(const CompressedColumn&) = delete;
+
+  void append(const value_type value)
+  {
+    if (!writing_ || blocks_.back().count == kBlockSize)
+    {
+      startBlock();
+    }
+    encoder_.encode(writer_, value);
+    ++blocks_.back().count;
+    ++size_;
+  }
+
+  /**
+   * @brief Flush the last block; further appends start a new block. Required before reading or writing.
+   */
+  void finish()
+  {
+    if (writing_)
+    {
+      std::vector<uint64_t>& words = blocks_.back().words;
+      words.resize(writer_.finish());
+      words.shrink_to_fit();
+      writing_ = false;
+    }
+  }
+
+  uint64_t size() const
+  {
+    return size_;
+  }
+
+  /**
+   * @brief Size of the column as serialized by write(), including block and column headers.
+   */
+  size_t compressedBytes() const
+  {
+    size_t bytes = sizeof(uint64_t);
+    for (const auto& block : blocks_)
+    {
+      bytes += sizeof(block.count) + sizeof(uint64_t) + block.words.size() * sizeof(uint64_t);
+    }
+    return bytes;
+  }
+
+  /**
+   * @brief Serialize the finished column as native-endian block headers and words.
+   */
+  void write(std::ostream& os) const
+  {
+    if (writing_)
+    {
+      throw std::runtime_error("Compressed column must be finish()ed before it is written");
+    }
+    const uint64_t num_blocks = blocks_.size();
+    os.write(reinterpret_cast<const char*>(&num_blocks), sizeof(num_blocks));
+    for (const auto& block : blocks_)
+    {
+      const uint64_t num_words = block.words.size();
+      os.write(reinterpret_cast<const char*>(&block.count), sizeof(block.count));
+      os.write(reinterpret_cast<const char*>(&num_words), sizeof(num_words));
+      os.write(reinterpret_cast<const char*>(block.words.data()),
+               static_cast<std::streamsize>(num_words * sizeof(uint64_t)));
+    }
+  }
+
+  void read(std::istream& is)
+  {
+    blocks_.clear();
+    writing_ = false;
+    size_ = 0;
+
+    uint64_t num_blocks = 0;
+    is.read(reinterpret_cast<char*>(&num_blocks), sizeof(num_blocks));
+    for (uint64_t b = 0; is && b < num_blocks; ++b)
+    {
+      Block block;
+      uint64_t num_words = 0;
+      is.read(reinterpret_cast<char*>(&block.count), sizeof(block.count));
+      is.read(reinterpret_cast<char*>(&num_words), sizeof(num_words));
+      if (is && (block.count == 0 || block.count > kBlockSize || num_words > maxWords(block.count)))
+      {
+        throw std::runtime_error("Corrupt compressed column");
+      }
+      block.words.resize(num_words);
+      is.read(reinterpret_cast<char*>(block.words.data()), static_cast<std::streamsize>(num_words * sizeof(uint64_t)));
+      size_ += block.count;
+      blocks_.push_back(std::move(block));
+    }
+    if (!is)
+    {
+      throw std::runtime_error("Truncated compressed column");
+    }
+  }
+
+ private:
+  static size_t maxWords(const size_t count)
+  {
+    return (count * Codec::kMaxBitsPerValue + 63) / 64;
+  }
+
+  void startBlock()
+  {
+    finish();
+    blocks_.emplace_back();
+    std::vector<uint64_t>& words = blocks_.back().words;
+    words.resize(maxWords(kBlockSize));
+    writer_ = BitWriter(words.data(), words.size());
+    encoder_ = typename Codec::Encoder();
+    writing_ = true;
+  }
+
+  std::vector<Block> blocks_;
+  BitWriter writer_;
+  bool writing_{false};
+  typename Codec::Encoder encoder_;
+  uint64_t size_{0};
+};
+
+using DoubleColumn = CompressedColumn<XorCodec>;
+using Int64Column = CompressedColumn<DeltaOfDeltaCodec>;
+
+/**
+ * @brief Replay a compressed MessageData value history through a Solver in fixed-size batches.
+ *
+ * Values are decoded into a small stack buffer and solved batch by batch, so the history is never
+ * materialized in full.
+ *
+ * @param sink Called as sink(msgs, outputs, count) for every decoded batch.
+ * @return The number of messages replayed.
+ */
+template <typename Sink>
+uint64_t replayCompressed(const DoubleColumn& values, Solver& solver, Sink&& sink)
+{
+  constexpr size_t kBatchSize = 256;
+  double vals[kBatchSize];
+  MessageData msgs[kBatchSize];
+  double out[kBatchSize];
+
+  DoubleColumn::Reader reader(values);
+  uint64_t replayed = 0;
+  while (const size_t n = reader.read(vals, kBatchSize))
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      msgs[i] = MessageData(vals[i]);
+    }
+    solver.solveBatch(msgs, out, n);
+    sink(static_cast<const MessageData*>(msgs), static_cast<const double*>(out), n);
+    replayed += n;
+  }
+  return replayed;
+}
+
+/*************************************************************************
+ * Allocation Tracking
+ ************************************************************************/
+
+// <testing/allocation_tracker.h>
+#include <cstdlib>
+
+/**
+ * @brief Per-thread counts of heap allocations made through global operator new.
+ *
+ * Counting only happens when the build defines TRACK_ALLOCATIONS, which replaces the global operator
+ * new/delete (as test builds do); otherwise enabled() is false and all counts stay zero. Wrap code in a
+ * Scope to measure the allocations it performs on the current thread.
+ */
+class AllocationTracker
+{
+ public:
+  struct Stats {
+    uint64_t allocations{0};
+    uint64_t bytes{0};
+  };
+
+  class Scope
+  {
+   public:
+    Scope() : start_(current())
+    {
+    }
+
+    Stats stats() const
+    {
+      const Stats now = current();
+      return {now.allocations - start_.allocations, now.bytes - start_.bytes};
+    }
+
+   private:
+    Stats start_;
+  };
+
+  static constexpr bool enabled()
+  {
+#ifdef TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  static Stats current()
+  {
+    return {allocations_, bytes_};
+  }
+
+  static void recordAllocation(const size_t bytes)
+  {
+    ++allocations_;
+    bytes_ += bytes;
+  }
+
+ private:
+  static thread_local uint64_t allocations_;
+  static thread_local uint64_t bytes_;
+};
+
+thread_local uint64_t AllocationTracker::allocations_ = 0;
+thread_local uint64_t AllocationTracker::bytes_ = 0;
+
+#ifdef TRACK_ALLOCATIONS
+// GCC cannot see that these replacements pair malloc with free when they are inlined into callers
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void* operator new(std::size_t size)
+{
+  AllocationTracker::recordAllocation(size);
+  if (void* p = std::malloc(size > 0 ? size : 1))
+  {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+  return ::operator new(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+  AllocationTracker::recordAllocation(size);
+  const auto alignment = static_cast<std::size_t>(align);
+  const std::size_t rounded = (std::max<std::size_t>(size, 1) + alignment - 1) / alignment * alignment;
+  if (void* p = std::aligned_alloc(alignment, rounded))
+  {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t align)
+{
+  return ::operator new(size, align);
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+#pragma GCC diagnostic pop
+#endif
+
+/*************************************************************************
+ * Profiling
+ ************************************************************************/
+
+// <profiling/perf_counters.h>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <ostream>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Counter values and wall-clock time accumulated over one or more profiled regions.
+ */
+struct PerfSample {
+  uint64_t cycles{0};
+  uint64_t instructions{0};
+  uint64_t branch_misses{0};
+  uint64_t cache_misses{0};
+  double seconds{0};
+  uint64_t calls{0};
+  uint64_t allocated_bytes{0};
+  bool has_counters{false};
+  bool multiplexed{false};  // counters were extrapolated from a partial run time
+
+  PerfSample& operator+=(const PerfSample& other)
+  {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    branch_misses += other.branch_misses;
+    cache_misses += other.cache_misses;
+    seconds += other.seconds;
+    calls += other.calls;
+    allocated_bytes += other.allocated_bytes;
+    has_counters = has_counters || other.has_counters;
+    multiplexed = multiplexed || other.multiplexed;
+    return *this;
+  }
+};
+
+/**
+ * @brief Hardware counters (cycles, instructions, branch-misses, cache-misses) read via perf_event_open.
+ *
+ * The counters form one group, so they always cover the same time slices. If the PMU had to multiplex the
+ * group, values are scaled by time enabled / time running and the sample is flagged as multiplexed.
+ *
+ * Counters are user-space only so that they work under the default perf_event_paranoid setting. When the
+ * kernel refuses to open them (non-Linux, containers, paranoid level too high) available() is false and
+ * only wall-clock time is measured.
+ */
+class PerfCounters
+{
+ public:
+  PerfCounters()
+  {
+#ifdef __linux__
+    const uint64_t configs[kNumCounters] = {PERF_COUNT_HW_CPU_CYCLES,
+                                            PERF_COUNT_HW_INSTRUCTIONS,
+                                            PERF_COUNT_HW_BRANCH_MISSES,
+                                            PERF_COUNT_HW_CACHE_MISSES};
+    // cycles leads a group so that all four are scheduled onto the PMU together and read atomically
+    for (size_t i = 0; i < kNumCounters; ++i)
+    {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = configs[i];
+      attr.disabled = i == 0 ? 1 : 0;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      fds_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds_[0], 0));
+      if (fds_[i] < 0)
+      {
+        closeAll();
+        return;
+      }
+    }
+    available_ = true;
+#endif
+  }
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  ~PerfCounters()
+  {
+    closeAll();
+  }
+
+  bool available() const
+  {
+    return available_;
+  }
+
+  void start()
+  {
+#ifdef __linux__
+    if (available_)
+    {
+      ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+    start_time_ = std::chrono::steady_clock::now();
+  }
+
+  PerfSample stop()
+  {
+    PerfSample sample;
+    sample.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count();
+#ifdef __linux__
+    if (available_)
+    {
+      ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+      // PERF_FORMAT_GROUP layout: nr, time_enabled, time_running, then one value per event
+      uint64_t data[3 + kNumCounters] = {0};
+      const ssize_t bytes = read(fds_[0], data, sizeof(data));
+      const uint64_t enabled = data[1];
+      const uint64_t running = data[2];
+      if (bytes == static_cast<ssize_t>(sizeof(data)) && data[0] == kNumCounters && running > 0)
+      {
+        // when the PMU was multiplexed the group only counted for part of the time; extrapolate
+        const double scale = static_cast<double>(enabled) / static_cast<double>(running);
+        auto scaled = [scale](const uint64_t v) { return static_cast<uint64_t>(static_cast<double>(v) * scale); };
+        sample.cycles = scaled(data[3]);
+        sample.instructions = scaled(data[4]);
+        sample.branch_misses = scaled(data[5]);
+        sample.cache_misses = scaled(data[6]);
+        sample.multiplexed = running < enabled;
+        sample.has_counters = true;
+      }
+    }
+#endif
+    return sample;
+  }
+
+ private:
+  static constexpr size_t kNumCounters = 4;
+
+  void closeAll()
+  {
+#ifdef __linux__
+    for (auto& fd : fds_)
+    {
+      if (fd >= 0)
+      {
+        close(fd);
+        fd = -1;
+      }
+    }
+#endif
+    available_ = false;
+  }
+
+  int fds_[kNumCounters] = {-1, -1, -1, -1};
+  bool available_{false};
+  std::chrono::steady_clock::time_point start_time_;
+};
+
+/**
+ * @brief Accumulates PerfSamples per ModifierType across profiled regions.
+ *
+ * Wrap a solve loop in a SolverProfiler::Scope to attribute its counters, and the bytes it allocated on the
+ * calling thread (when built with TRACK_ALLOCATIONS), to a modifier type. Counters are
+ * read once per scope rather than once per solve(), so wrap whole loops or batches to keep the syscall
+ * overhead out of the measurement.
+ */
+class SolverProfiler
+{
+ public:
+  using ModifierType = IValueModifierFactory::ModifierType;
+
+  class Scope
+  {
+   public:
+    Scope(SolverProfiler& profiler, const ModifierType mod_type, const uint64_t calls)
+      : profiler_(profiler), mod_type_(mod_type), calls_(calls)
+    {
+      profiler_.counters_.start();
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    ~Scope()
+    {
+      PerfSample sample = profiler_.counters_.stop();
+      sample.calls = calls_;
+      sample.allocated_bytes = allocations_.stats().bytes;
+      profiler_.samples_[mod_type_] += sample;
+    }
+
+   private:
+    SolverProfiler& profiler_;
+    ModifierType mod_type_;
+    uint64_t calls_;
+    AllocationTracker::Scope allocations_;
+  };
+
+  bool countersAvailable() const
+  {
+    return counters_.available();
+  }
+
+  const std::map<ModifierType, PerfSample>& samples() const
+  {
+    return samples_;
+  }
+
+  /**
+   * @brief Print per-call averages for each profiled modifier type.
+   */
+  void report(std::ostream& os) const
+  {
+    os << std::left << std::setw(10) << "modifier" << std::right << std::setw(12) << "calls" << std::setw(12)
+       << "ns/call" << std::setw(14) << "cycles/call" << std::setw(8) << "IPC" << std::setw(14) << "br-miss/call"
+       << std::setw(14) << "$-miss/call" << std::setw(12) << "B/call" << '\n';
+
+    for (const auto& entry : samples_)
+    {
+      const PerfSample& s = entry.second;
+      const double calls = s.calls > 0 ? static_cast<double>(s.calls) : 1.0;
+
+      os << std::left << std::setw(10) << modifierTypeName(entry.first) << std::right << std::setw(12) << s.calls
+         << std::setw(12) << std::fixed << std::setprecision(2) << 1e9 * s.seconds / calls;
+      if (s.has_counters)
+      {
+        const double ipc = s.cycles > 0 ? static_cast<double>(s.instructions) / static_cast<double>(s.cycles) : 0;
+        os << std::setw(14) << static_cast<double>(s.cycles) / calls << std::setw(8) << ipc << std::setw(14)
+           << static_cast<double>(s.branch_misses) / calls << std::setw(14)
+           << static_cast<double>(s.cache_misses) / calls;
+      }
+      else
+      {
+        os << std::setw(14) << "n/a" << std::setw(8) << "n/a" << std::setw(14) << "n/a" << std::setw(14) << "n/a";
+      }
+      if (AllocationTracker::enabled())
+      {
+        os << std::setw(12) << static_cast<double>(s.allocated_bytes) / calls;
+      }
+      else
+      {
+        os << std::setw(12) << "n/a";
+      }
+      os << (s.multiplexed ? "  (multiplexed, scaled)" : "") << '\n';
+    }
+    os.unsetf(std::ios::floatfield);
+  }
+
+ private:
+  PerfCounters counters_;
+  std::map<ModifierType, PerfSample> samples_;
+};
+
+/*************************************************************************
+ * Load Generator
+ ************************************************************************/
+
+// <load_generator/latency_histogram.h>
+
+/**
+ * @brief Log-linear latency histogram in nanoseconds with roughly 3% relative precision.
+ *
+ * Values below 64 are recorded exactly; larger values share 32 sub-buckets per power of two. Histograms are
+ * mergeable so that each load-generator thread can record without synchronization.
+ */
+class LatencyHistogram
+{
+ public:
+  LatencyHistogram() : counts_(kNumBuckets, 0)
+  {
+  }
+
+  void record(const uint64_t value_ns)
+  {
+    ++counts_[bucketIndex(value_ns)];
+    ++total_;
+    max_ = std::max(max_, value_ns);
+  }
+
+  void merge(const LatencyHistogram& other)
+  {
+    for (size_t i = 0; i < kNumBuckets; ++i)
+    {
+      counts_[i] += other.counts_[i];
+    }
+    total_ += other.total_;
+    max_ = std::max(max_, other.max_);
+  }
+
+  uint64_t count() const
+  {
+    return total_;
+  }
+
+  uint64_t max() const
+  {
+    return max_;
+  }
+
+  /**
+   * @brief The smallest recorded bucket bound such that at least `percentile`% of values are not above it.
+   */
+  uint64_t percentile(const double percentile) const
+  {
+    if (total_ == 0)
+    {
+      return 0;
+    }
+    const auto rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total_)));
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < kNumBuckets; ++i)
+    {
+      cumulative += counts_[i];
+      if (cumulative >= std::max<uint64_t>(rank, 1))
+      {
+        return std::min(bucketUpperBound(i), max_);
+      }
+    }
+    return max_;
+  }
+
+ private:
+  static constexpr unsigned kSubBucketBits = 5;
+  static constexpr size_t kLinearLimit = size_t{1} << (kSubBucketBits + 1);
+  static constexpr size_t kNumBuckets = kLinearLimit + (64 - kSubBucketBits - 1) * (size_t{1} << kSubBucketBits);
+
+  static size_t bucketIndex(const uint64_t v)
+  {
+    if (v < kLinearLimit)
+    {
+      return static_cast<size_t>(v);
+    }
+    const unsigned e = 63 - static_cast<unsigned>(__builtin_clzll(v));
+    const uint64_t mantissa = (v >> (e - kSubBucketBits)) - (uint64_t{1} << kSubBucketBits);
+    return kLinearLimit + (e - kSubBucketBits - 1) * (size_t{1} << kSubBucketBits) + static_cast<size_t>(mantissa);
+  }
+
+  static uint64_t bucketUpperBound(const size_t idx)
+  {
+    if (idx < kLinearLimit)
+    {
+      return idx;
+    }
+    const size_t offset = idx - kLinearLimit;
+    const unsigned e = static_cast<unsigned>(offset >> kSubBucketBits) + kSubBucketBits + 1;
+    const uint64_t mantissa = (offset & ((size_t{1} << kSubBucketBits) - 1)) + (uint64_t{1} << kSubBucketBits);
+    return ((mantissa + 1) << (e - kSubBucketBits)) - 1;
+  }
+
+  std::vector<uint64_t> counts_;
+  uint64_t total_{0};
+  uint64_t max_{0};
+};
+
+// <load_generator/load_generator.h>
+#include <random>
+#include <thread>
+
+/**
+ * @brief Configuration of an open-loop load-generator run.
+ */
+struct LoadGeneratorConfig {
+  enum class Arrival
+  {
+    FIXED,
+    POISSON
+  };
+
+  double rate_per_sec{1e6};  // total arrival rate across all threads
+  Arrival arrival{Arrival::FIXED};
+  size_t num_threads{1};
+  double duration_sec{1.0};
+  double clipping_limit{42};
+  std::vector<IValueModifierFactory::ModifierType> mod_types{IValueModifierFactory::ModifierType::SQUARE};
+};
+
+struct LoadGeneratorResult {
+  LatencyHistogram latency;
+  std::map<IValueModifierFactory::ModifierType, LatencyHistogram> latency_per_type;
+  uint64_t scheduled{0};
+  uint64_t completed{0};
+  double elapsed_sec{0};
+
+  double achievedRate() const
+  {
+    return elapsed_sec > 0 ? static_cast<double>(completed) / elapsed_sec : 0;
+  }
+};
+
+/**
+ * @brief Drive Solver::updateDataCb()/solve() at an open-loop arrival rate.
+ *
+ * Each thread owns one Solver per configured modifier type and issues requests on a precomputed schedule,
+ * cycling through the types so that every type is driven regardless of the thread count. Latency is measured
+ * from each request's intended arrival time rather than from when the thread got around to issuing it, so
+ * queueing delay caused by a slow request is charged to every request that should have arrived behind it
+ * (correcting for coordinated omission).
+ */
+LoadGeneratorResult runLoadGenerator(IValueModifierFactory& value_modifier_factory, const LoadGeneratorConfig& config)
+{
+  using Clock = std::chrono::steady_clock;
+  if (config.num_threads == 0 || !(config.rate_per_sec > 0) || !(config.duration_sec > 0) ||
+      config.mod_types.empty())
+  {
+    throw std::runtime_error("Load generator needs a positive rate, thread count and duration, and a modifier type");
+  }
+
+  const size_t num_types = config.mod_types.size();
+
+  struct ThreadResult {
+    std::vector<LatencyHistogram> latency_per_type;
+    uint64_t scheduled{0};
+    uint64_t completed{0};
+  };
+
+  std::vector<ThreadResult> thread_results(config.num_threads);
+  std::vector<std::vector<std::unique_ptr<Solver>>> solvers(config.num_threads);
+  for (size_t t = 0; t < config.num_threads; ++t)
+  {
+    thread_results[t].latency_per_type.resize(num_types);
+    for (const auto mod_type : config.mod_types)
+    {
+      solvers[t].push_back(
+          std::make_unique<Solver>(config.clipping_limit, value_modifier_factory.makeValueModifier(mod_type)));
+    }
+  }
+
+  const double interval_ns = 1e9 * static_cast<double>(config.num_threads) / config.rate_per_sec;
+  const auto duration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(config.duration_sec));
+  // give threads time to spawn so that none starts behind schedule
+  const Clock::time_point start = Clock::now() + std::chrono::milliseconds(1);
+  const Clock::time_point end = start + duration;
+  // an overloaded run is abandoned rather than left to drain an unbounded backlog
+  const Clock::time_point give_up = end + duration;
+
+  auto worker = [&](const size_t t) {
+    ThreadResult& result = thread_results[t];
+    // offset each thread's starting type so that types are spread evenly across threads at any instant
+    size_t type_idx = t % num_types;
+    std::mt19937_64 rng(t + 1);
+    std::exponential_distribution<double> exp_dist(1.0 / interval_ns);
+
+    double offset_ns = config.arrival == LoadGeneratorConfig::Arrival::POISSON
+                           ? exp_dist(rng)
+                           : interval_ns * static_cast<double>(t) / static_cast<double>(config.num_threads);
+    double val = 1.0;
+    for (;;)
+    {
+      const Clock::time_point intended =
+          start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::nano>(offset_ns));
+      if (intended >= end)
+      {
+        break;
+      }
+      ++result.scheduled;
+
+      Clock::time_point now = Clock::now();
+      while (now < intended)
+      {
+        now = Clock::now();
+      }
+      if (now > give_up)
+      {
+        break;
+      }
+
+      Solver& solver = *solvers[t][type_idx];
+      solver.updateDataCb(MessageData(val));
+      volatile double sln = solver.solve();
+      (void)sln;
+      const Clock::time_point done = Clock::now();
+
+      const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(done - intended);
+      result.latency_per_type[type_idx].record(static_cast<uint64_t>(latency.count()));
+      ++result.completed;
+      type_idx = type_idx + 1 == num_types ? 0 : type_idx + 1;
+
+      val = val < 1000.0 ? val + 1.0 : 1.0;
+      offset_ns += config.arrival == LoadGeneratorConfig::Arrival::POISSON ? exp_dist(rng) : interval_ns;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < config.num_threads; ++t)
+  {
+    threads.emplace_back(worker, t);
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  LoadGeneratorResult result;
+  result.elapsed_sec = std::chrono::duration<double>(std::max(Clock::now(), end) - start).count();
+  for (size_t t = 0; t < config.num_threads; ++t)
+  {
+    for (size_t i = 0; i < num_types; ++i)
+    {
+      result.latency.merge(thread_results[t].latency_per_type[i]);
+      result.latency_per_type[config.mod_types[i]].merge(thread_results[t].latency_per_type[i]);
+    }
+    result.scheduled += thread_results[t].scheduled;
+    result.completed += thread_results[t].completed;
+  }
+  return result;
+}
+
+/**
+ * @brief Find the highest arrival rate whose p99 latency stays within the SLO.
+ *
+ * Starting from config.rate_per_sec, the rate is doubled until the SLO breaks (or halved until it holds), then
+ * bisected between the last passing and first failing rates. A run fails if its p99 exceeds the SLO or if it
+ * could not issue every scheduled request.
+ *
+ * @return The highest passing rate in requests per second, or 0 if even the starting rate fails.
+ */
+double findMaxSustainableRate(IValueModifierFactory& value_modifier_factory,
+                              LoadGeneratorConfig config,
+                              const uint64_t p99_slo_ns,
+                              const size_t num_bisections = 4)
+{
+  auto passes = [&](const double rate) {
+    config.rate_per_sec = rate;
+    const LoadGeneratorResult result = runLoadGenerator(value_modifier_factory, config);
+    return result.completed == result.scheduled && result.latency.percentile(99) <= p99_slo_ns;
+  };
+
+  const size_t max_steps = 20;
+  double good = 0;
+  double bad = config.rate_per_sec;
+  if (passes(bad))
+  {
+    // ramp up until the SLO breaks
+    good = bad;
+    for (size_t i = 0; i < max_steps && passes(2 * good); ++i)
+    {
+      good *= 2;
+    }
+    bad = 2 * good;
+  }
+  else
+  {
+    // back off until the SLO holds
+    for (size_t i = 0; i < max_steps && good == 0; ++i)
+    {
+      const double rate = 0.5 * bad;
+      if (passes(rate))
+      {
+        good = rate;
+      }
+      else
+      {
+        bad = rate;
+      }
+    }
+  }
+  if (good == 0)
+  {
+    return 0;
+  }
+
+  for (size_t i = 0; i < num_bisections; ++i)
+  {
+    const double mid = 0.5 * (good + bad);
+    if (passes(mid))
+    {
+      good = mid;
+    }
+    else
+    {
+      bad = mid;
+    }
+  }
+  return good;
+}
+
+/**
+ * @brief Print latency percentiles of a load-generator run, overall and per modifier type.
+ */
+void reportLoadGeneratorResult(const LoadGeneratorResult& result, std::ostream& os)
+{
+  auto printRow = [&os](const std::string& name, const LatencyHistogram& h) {
+    os << std::left << std::setw(10) << name << std::right << std::setw(12) << h.count() << std::setw(10)
+       << h.percentile(50) << std::setw(10) << h.percentile(90) << std::setw(10) << h.percentile(99)
+       << std::setw(10) << h.percentile(99.9) << std::setw(12) << h.max() << '\n';
+  };
+
+  os << "scheduled: " << result.scheduled << ", completed: " << result.completed
+     << ", achieved rate: " << static_cast<uint64_t>(result.achievedRate()) << "/s\n";
+  os << std::left << std::setw(10) << "modifier" << std::right << std::setw(12) << "count" << std::setw(10)
+     << "p50 ns" << std::setw(10) << "p90 ns" << std::setw(10) << "p99 ns" << std::setw(10) << "p99.9 ns"
+     << std::setw(12) << "max ns" << '\n';
+  for (const auto& entry : result.latency_per_type)
+  {
+    printRow(modifierTypeName(entry.first), entry.second);
+  }
+  printRow("ALL", result.latency);
+}
+
+/*************************************************************************
+ * Shared-Memory Channel
+ ************************************************************************/
+
+// <ipc/shm_ring_channel.h>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#endif
+
+static_assert(std::is_trivially_copyable<MessageData>::value, "MessageData must be shareable across processes");
+
+/**
+ * @brief Single-producer/single-consumer ring of MessageData batches in shared memory.
+ *
+ * The ring lives in a memfd (inherited across fork(), or passed to another process) or a named POSIX shm
+ * object. The producer fills a batch in place and publishes it; the consumer reads it in place, so no
+ * message is copied across the process boundary. Both sides spin briefly when the ring is empty or full and
+ * then sleep on a futex, which the other side only wakes when it knows someone is waiting.
+ */
+class ShmRingChannel
+{
+ public:
+  /**
+   * @brief Create an anonymous channel backed by memfd_create(); share it via fork() or by passing fd().
+   */
+  static ShmRingChannel createAnonymous(const uint32_t num_slots, const uint32_t batch_capacity)
+  {
+#ifdef __linux__
+    const int fd = memfd_create("shm_ring_channel", MFD_CLOEXEC);
+    if (fd < 0)
+    {
+      throw std::runtime_error("memfd_create failed");
+    }
+    return ShmRingChannel(fd, num_slots, batch_capacity);
+#else
+    (void)num_slots;
+    (void)batch_capacity;
+    throw std::runtime_error("Shared-memory channels require Linux");
+#endif
+  }
+
+  /**
+   * @brief Create a channel backed by the named POSIX shm object `name` (e.g., "/solver_feed").
+   */
+  static ShmRingChannel createNamed(const std::string& name, const uint32_t num_slots, const uint32_t batch_capacity)
+  {
+#ifdef __linux__
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+    {
+      throw std::runtime_error("shm_open failed to create " + name);
+    }
+    return ShmRingChannel(fd, num_slots, batch_capacity);
+#else
+    (void)name;
+    (void)num_slots;
+    (void)batch_capacity;
+    throw std::runtime_error("Shared-memory channels require Linux");
+#endif
+  }
+
+  /**
+   * @brief Map an existing channel from a named POSIX shm object or from an inherited/passed memfd.
+   */
+  static ShmRingChannel openNamed(const std::string& name)
+  {
+#ifdef __linux__
+    const int fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0)
+    {
+      throw std::runtime_error("shm_open failed to open " + name);
+    }
+    return ShmRingChannel(fd);
+#else
+    (void)name;
+    throw std::runtime_error("Shared-memory channels require Linux");
+#endif
+  }
+
+  static ShmRingChannel openFd(const int fd)
+  {
+    return ShmRingChannel(fd);
+  }
+
+  static void unlinkNamed(const std::string& name)
+  {
+#ifdef __linux__
+    shm_unlink(name.c_str());
+#else
+    (void)name;
+#endif
+  }
+
+  ShmRingChannel(ShmRingChannel&& other) noexcept
+    : fd_(other.fd_), base_(other.base_), size_(other.size_), header_(other.header_)
+  {
+    other.fd_ = -1;
+    other.base_ = nullptr;
+    other.header_ = nullptr;
+  }
+
+  ShmRingChannel(const ShmRingChannel&) = delete;
+  ShmRingChannel& operator=(const ShmRingChannel&) = delete;
+  ShmRingChannel& operator=(ShmRingChannel&&) = delete;
+
+  ~ShmRingChannel()
+  {
+#ifdef __linux__
+    if (base_)
+    {
+      munmap(base_, size_);
+    }
+    if (fd_ >= 0)
+    {
+      ::close(fd_);
+    }
+#endif
+  }
+
+  int fd() const
+  {
+    return fd_;
+  }
+
+  uint32_t batchCapacity() const
+  {
+    return header_->batch_capacity;
+  }
+
+  /*** Producer side ***/
+
+  /**
+   * @brief Slot to fill with up to batchCapacity() messages, blocking while the ring is full.
+   */
+  MessageData* beginBatch()
+  {
+    const uint32_t head = header_->head.load(std::memory_order_relaxed);
+    waitUntil(header_->space_seq, header_->producer_waiting, [this, head] {
+      return head - header_->tail.load(std::memory_order_acquire) < header_->num_slots;
+    });
+    return slotMessages(head);
+  }
+
+  /**
+   * @brief Publish the batch filled via beginBatch() holding `count` messages.
+   */
+  void publishBatch(const uint32_t count)
+  {
+    if (count > header_->batch_capacity)
+    {
+      throw std::runtime_error("Batch of " + std::to_string(count) + " messages exceeds the channel's capacity");
+    }
+    const uint32_t head = header_->head.load(std::memory_order_relaxed);
+    slotCount(head) = count;
+    header_->head.store(head + 1, std::memory_order_release);
+    notify(header_->data_seq, header_->consumer_waiting);
+  }
+
+  /**
+   * @brief Signal that no more batches will be published.
+   */
+  void close()
+  {
+    header_->closed.store(1, std::memory_order_release);
+    notify(header_->data_seq, header_->consumer_waiting);
+  }
+
+  /*** Consumer side ***/
+
+  /**
+   * @brief Next published batch, blocking while the ring is empty.
+   *
+   * @param count Receives the number of messages in the batch.
+   * @return The batch in shared memory, valid until releaseBatch(), or nullptr once closed and drained.
+   * @throws std::runtime_error if the producer published a count above batchCapacity().
+   */
+  const MessageData* waitBatch(uint32_t& count)
+  {
+    const uint32_t tail = header_->tail.load(std::memory_order_relaxed);
+    waitUntil(header_->data_seq, header_->consumer_waiting, [this, tail] {
+      return header_->head.load(std::memory_order_acquire) != tail ||
+             header_->closed.load(std::memory_order_acquire) != 0;
+    });
+    if (header_->head.load(std::memory_order_acquire) == tail)
+    {
+      count = 0;
+      return nullptr;
+    }
+    // the count is written by another process, so it is read once and checked before anyone indexes with it
+    const uint32_t published = slotCount(tail);
+    if (published > header_->batch_capacity)
+    {
+      throw std::runtime_error("Shared-memory batch count exceeds the channel's capacity");
+    }
+    count = published;
+    return slotMessages(tail);
+  }
+
+  /**
+   * @brief Return the batch obtained from waitBatch() to the producer.
+   */
+  void releaseBatch()
+  {
+    header_->tail.store(header_->tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    notify(header_->space_seq, header_->producer_waiting);
+  }
+
+ private:
+  static constexpr uint32_t kMagic = 0x53524348;  // "SRCH"
+  static constexpr size_t kCacheLine = 64;
+  static constexpr int kSpinIterations = 1000;
+
+  struct alignas(kCacheLine) Header {
+    alignas(kCacheLine) std::atomic<uint32_t> head;
+    std::atomic<uint32_t> data_seq;
+    std::atomic<uint32_t> consumer_waiting;
+    std::atomic<uint32_t> closed;
+    alignas(kCacheLine) std::atomic<uint32_t> tail;
+    std::atomic<uint32_t> space_seq;
+    std::atomic<uint32_t> producer_waiting;
+    alignas(kCacheLine) std::atomic<uint32_t> magic;
+    uint32_t num_slots;
+    uint32_t batch_capacity;
+  };
+
+  struct Slot {
+    uint32_t count;
+    MessageData msgs[1];  // only used for offsetof(); a slot holds batch_capacity messages
+  };
+
+  static_assert(std::atomic<uint32_t>::is_always_lock_free, "futex words must be lock free");
+
+  static size_t slotStride(const uint32_t batch_capacity)
+  {
+    const size_t bytes = offsetof(Slot, msgs) + batch_capacity * sizeof(MessageData);
+    return (bytes + kCacheLine - 1) / kCacheLine * kCacheLine;
+  }
+
+  ShmRingChannel(const int fd, const uint32_t num_slots, const uint32_t batch_capacity) : fd_(fd)
+  {
+    if (num_slots == 0 || batch_capacity == 0)
+    {
+      ::close(fd_);
+      throw std::runtime_error("Shared-memory channel needs at least one slot and one message per batch");
+    }
+    size_ = sizeof(Header) + num_slots * slotStride(batch_capacity);
+#ifdef __linux__
+    if (ftruncate(fd_, static_cast<off_t>(size_)) != 0)
+    {
+      ::close(fd_);
+      throw std::runtime_error("ftruncate of shared-memory channel failed");
+    }
+#endif
+    map();
+    header_ = new (base_) Header();
+    header_->num_slots = num_slots;
+    header_->batch_capacity = batch_capacity;
+    // publishes the geometry above to openers, which load the magic with acquire
+    header_->magic.store(kMagic, std::memory_order_release);
+  }
+
+  explicit ShmRingChannel(const int fd) : fd_(fd)
+  {
+#ifdef __linux__
+    struct stat st;
+    if (fstat(fd_, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header))
+    {
+      ::close(fd_);
+      throw std::runtime_error("Shared-memory channel is missing or truncated");
+    }
+    size_ = static_cast<size_t>(st.st_size);
+#endif
+    map();
+    header_ = static_cast<Header*>(base_);
+    if (header_->magic.load(std::memory_order_acquire) != kMagic)
+    {
+      unmapAndThrow("Shared-memory object is not a ShmRingChannel");
+    }
+    if (header_->num_slots == 0 || header_->batch_capacity == 0)
+    {
+      unmapAndThrow("Shared-memory channel has an empty geometry");
+    }
+    // the object must be exactly as large as its header says, or slotBytes() would run past the mapping
+    const size_t stride = slotStride(header_->batch_capacity);
+    const size_t slot_bytes = size_ - sizeof(Header);
+    if (slot_bytes % stride != 0 || slot_bytes / stride != header_->num_slots)
+    {
+      unmapAndThrow("Shared-memory channel size does not match its header");
+    }
+  }
+
+  [[noreturn]] void unmapAndThrow(const std::string& what)
+  {
+#ifdef __linux__
+    munmap(base_, size_);
+    ::close(fd_);
+#endif
+    base_ = nullptr;
+    header_ = nullptr;
+    fd_ = -1;
+    throw std::runtime_error(what);
+  }
+
+  void map()
+  {
+#ifdef __linux__
+    void* base = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (base == MAP_FAILED)
+    {
+      ::close(fd_);
+      fd_ = -1;
+      throw std::runtime_error("mmap of shared-memory channel failed");
+    }
+    base_ = base;
+#endif
+  }
+
+  char* slotBytes(const uint32_t seq)
+  {
+    char* slots = static_cast<char*>(base_) + sizeof(Header);
+    return slots + (seq % header_->num_slots) * slotStride(header_->batch_capacity);
+  }
+
+  uint32_t& slotCount(const uint32_t seq)
+  {
+    return *reinterpret_cast<uint32_t*>(slotBytes(seq) + offsetof(Slot, count));
+  }
+
+  MessageData* slotMessages(const uint32_t seq)
+  {
+    return reinterpret_cast<MessageData*>(slotBytes(seq) + offsetof(Slot, msgs));
+  }
+
+  /**
+   * @brief Spin, then sleep on the futex word `seq`, until `ready()` holds.
+   *
+   * `seq` acts as an event count: it is bumped by the other side after every state change, so reading it
+   * before re-checking `ready()` guarantees the futex wait returns if anything changed in between.
+   */
+  template <typename Pred>
+  static void waitUntil(std::atomic<uint32_t>& seq, std::atomic<uint32_t>& waiting, Pred ready)
+  {
+    for (int i = 0; i < kSpinIterations; ++i)
+    {
+      if (ready())
+      {
+        return;
+      }
+    }
+    for (;;)
+    {
+      waiting.store(1, std::memory_order_seq_cst);
+      const uint32_t observed = seq.load(std::memory_order_seq_cst);
+      if (ready())
+      {
+        break;
+      }
+#ifdef __linux__
+      syscall(SYS_futex, reinterpret_cast<uint32_t*>(&seq), FUTEX_WAIT, observed, nullptr, nullptr, 0);
+#endif
+    }
+    waiting.store(0, std::memory_order_relaxed);
+  }
+
+  static void notify(std::atomic<uint32_t>& seq, std::atomic<uint32_t>& waiting)
+  {
+    seq.fetch_add(1, std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_seq_cst) != 0)
+    {
+#ifdef __linux__
+      syscall(SYS_futex, reinterpret_cast<uint32_t*>(&seq), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+#endif
+    }
+  }
+
+  int fd_{-1};
+  void* base_{nullptr};
+  size_t size_{0};
+  Header* header_{nullptr};
+};
+
+// <ipc/shm_solver_consumer.h>
+
+/**
+ * @brief Consumer-side adapter feeding batches from a ShmRingChannel straight into one or more Solvers.
+ *
+ * Each batch is solved in place in shared memory, so the input is never copied.
+ */
+class ShmSolverConsumer
+{
+ public:
+  ShmSolverConsumer(ShmRingChannel& channel, std::vector<Solver*> solvers)
+    : channel_(channel), solvers_(std::move(solvers)), out_(channel.batchCapacity())
+  {
+    assert(!solvers_.empty());
+  }
+
+  /**
+   * @brief Solve batches until the producer closes the channel.
+   *
+   * @param sink Called as sink(solver_index, msgs, outputs, count) for every solver and batch.
+   * @return The number of messages consumed.
+   */
+  template <typename Sink>
+  uint64_t run(Sink&& sink)
+  {
+    uint64_t consumed = 0;
+    uint32_t count = 0;
+    while (const MessageData* msgs = channel_.waitBatch(count))
+    {
+      for (size_t s = 0; s < solvers_.size(); ++s)
+      {
+        solvers_[s]->solveBatch(msgs, out_.data(), count);
+        sink(s, msgs, static_cast<const double*>(out_.data()), count);
+      }
+      channel_.releaseBatch();
+      consumed += count;
+    }
+    return consumed;
+  }
+
+ private:
+  ShmRingChannel& channel_;
+  std::vector<Solver*> solvers_;
+  std::vector<double> out_;
+};
+
+/*************************************************************************
+ * Scheduling
+ ************************************************************************/
+
+// <scheduling/deadline_scheduler.h>
+#include <deque>
+#include <queue>
+
+/**
+ * @brief Schedules solve() work across many streams: critical streams earliest-deadline-first, best-effort
+ * streams in batches when no critical work is pending.
+ *
+ * Each critical message gets an absolute deadline of its arrival time plus its stream's relative deadline,
+ * and a deadline miss is counted when it completes late. Best-effort streams are served round-robin, one batch
+ * at a time, so a critical arrival waits for at most one best-effort batch; under overload their bounded
+ * backlogs drop the oldest messages instead of delaying critical work.
+ */
+class DeadlineScheduler
+{
+ public:
+  using StreamId = uint32_t;
+  using Clock = uint64_t (*)();
+
+  struct StreamPolicy {
+    enum class Class
+    {
+      CRITICAL,
+      BEST_EFFORT
+    };
+
+    Class cls{Class::BEST_EFFORT};
+    uint64_t relative_deadline_ns{0};
+    size_t max_queue{4096};
+
+    /**
+     * @brief A stream solved earliest-deadline-first. Its backlog is unbounded: critical messages are never
+     * dropped, so a critical stream submitting faster than it is served grows memory without limit.
+     */
+    static StreamPolicy critical(const uint64_t relative_deadline_ns)
+    {
+      StreamPolicy policy;
+      policy.cls = Class::CRITICAL;
+      policy.relative_deadline_ns = relative_deadline_ns;
+      return policy;
+    }
+
+    /**
+     * @brief A batched stream keeping at most `max_queue` (> 0) messages, dropping the oldest beyond that.
+     */
+    static StreamPolicy bestEffort(const size_t max_queue)
+    {
+      StreamPolicy policy;
+      policy.max_queue = max_queue;
+      return policy;
+    }
+  };
+
+  struct StreamStats {
+    uint64_t processed{0};
+    uint64_t deadline_misses{0};
+    uint64_t dropped{0};
+  };
+
+  static uint64_t steadyNowNs()
+  {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+  }
+
+  explicit DeadlineScheduler(const size_t best_effort_batch = 64, Clock clock = &steadyNowNs)
+    : best_effort_batch_(best_effort_batch)
+    , clock_(clock)
+    , batch_msgs_(best_effort_batch)
+    , batch_out_(best_effort_batch)
+  {
+    if (best_effort_batch_ == 0)
+    {
+      throw std::runtime_error("Best-effort batches need room for at least one message");
+    }
+  }
+
+  /**
+   * @brief Create a stream whose Solver uses a modifier of `mod_type` from `value_modifier_factory`.
+   */
+  StreamId createStream(IValueModifierFactory& value_modifier_factory,
+                        const IValueModifierFactory::ModifierType mod_type,
+                        const double clipping_limit,
+                        const StreamPolicy& policy)
+  {
+    if (policy.cls == StreamPolicy::Class::BEST_EFFORT && policy.max_queue == 0)
+    {
+      throw std::runtime_error("Best-effort stream needs a queue of at least one message");
+    }
+    const auto id = static_cast<StreamId>(streams_.size());
+    streams_.push_back(
+        std::make_unique<Stream>(policy, clipping_limit, value_modifier_factory.makeValueModifier(mod_type)));
+    if (policy.cls == StreamPolicy::Class::BEST_EFFORT)
+    {
+      best_effort_ids_.push_back(id);
+    }
+    return id;
+  }
+
+  /**
+   * @brief Queue a message that arrived now on `stream_id`.
+   */
+  void submit(const StreamId stream_id, const MessageData& msg)
+  {
+    Stream& stream = *streams_.at(stream_id);
+    if (stream.policy.cls == StreamPolicy::Class::CRITICAL)
+    {
+      const uint64_t deadline = clock_() + stream.policy.relative_deadline_ns;
+      stream.queue.push_back({msg, deadline});
+      edf_queue_.push({deadline, stream_id});
+      return;
+    }
+
+    if (stream.queue.size() >= stream.policy.max_queue)
+    {
+      stream.queue.pop_front();
+      ++stream.stats.dropped;
+      --best_effort_pending_;
+    }
+    stream.queue.push_back({msg, 0});
+    ++best_effort_pending_;
+  }
+
+  /**
+   * @brief Run one unit of work: the earliest-deadline critical message, else one best-effort batch.
+   *
+   * @param sink Called as sink(stream_id, msgs, outputs, count) with the solved messages.
+   * @return The number of messages solved; 0 if nothing is pending.
+   */
+  template <typename Sink>
+  size_t runOnce(Sink&& sink)
+  {
+    if (!edf_queue_.empty())
+    {
+      const StreamId id = edf_queue_.top().stream_id;
+      edf_queue_.pop();
+
+      Stream& stream = *streams_[id];
+      const Pending pending = stream.queue.front();
+      stream.queue.pop_front();
+
+      stream.solver.updateDataCb(pending.msg);
+      const double out = stream.solver.solve();
+      if (clock_() > pending.deadline)
+      {
+        ++stream.stats.deadline_misses;
+      }
+      ++stream.stats.processed;
+      sink(id, &pending.msg, &out, size_t{1});
+      return 1;
+    }
+
+    if (best_effort_pending_ == 0)
+    {
+      return 0;
+    }
+    for (size_t tries = 0; tries < best_effort_ids_.size(); ++tries)
+    {
+      const StreamId id = best_effort_ids_[next_best_effort_];
+      next_best_effort_ = (next_best_effort_ + 1) % best_effort_ids_.size();
+
+      Stream& stream = *streams_[id];
+      const size_t n = std::min(best_effort_batch_, stream.queue.size());
+      if (n == 0)
+      {
+        continue;
+      }
+      for (size_t i = 0; i < n; ++i)
+      {
+        batch_msgs_[i] = stream.queue.front().msg;
+        stream.queue.pop_front();
+      }
+      best_effort_pending_ -= n;
+
+      stream.solver.solveBatch(batch_msgs_.data(), batch_out_.data(), n);
+      stream.stats.processed += n;
+      sink(id, static_cast<const MessageData*>(batch_msgs_.data()), static_cast<const double*>(batch_out_.data()), n);
+      return n;
+    }
+    return 0;
+  }
+
+  /**
+   * @brief Run until no work is pending.
+   *
+   * @return The number of messages solved.
+   */
+  template <typename Sink>
+  uint64_t drain(Sink&& sink)
+  {
+    uint64_t total = 0;
+    while (const size_t n = runOnce(sink))
+    {
+      total += n;
+    }
+    return total;
+  }
+
+  const StreamStats& stats(const StreamId stream_id) const
+  {
+    return streams_.at(stream_id)->stats;
+  }
+
+  uint64_t totalDeadlineMisses() const
+  {
+    uint64_t misses = 0;
+    for (const auto& stream : streams_)
+    {
+      misses += stream->stats.deadline_misses;
+    }
+    return misses;
+  }
+
+  size_t pending() const
+  {
+    return edf_queue_.size() + best_effort_pending_;
+  }
+
+ private:
+  struct Pending {
+    MessageData msg;
+    uint64_t deadline;
+  };
+
+  struct Stream {
+    Stream(const StreamPolicy& p, const double clipping_limit, std::unique_ptr<IValueModifier> value_modifier_ptr)
+      : policy(p), solver(clipping_limit, std::move(value_modifier_ptr))
+    {
+    }
+
+    StreamPolicy policy;
+    Solver solver;
+    std::deque<Pending> queue;
+    StreamStats stats;
+  };
+
+  struct DeadlineEntry {
+    uint64_t deadline;
+    StreamId stream_id;
+
+    bool operator>(const DeadlineEntry& other) const
+    {
+      return deadline > other.deadline;
+    }
+  };
+
+  size_t best_effort_batch_;
+  Clock clock_;
+  std::vector<std::unique_ptr<Stream>> streams_;
+  std::vector<StreamId> best_effort_ids_;
+  size_t next_best_effort_{0};
+  size_t best_effort_pending_{0};
+  std::priority_queue<DeadlineEntry, std::vector<DeadlineEntry>, std::greater<DeadlineEntry>> edf_queue_;
+  std::vector<MessageData> batch_msgs_;
+  std::vector<double> batch_out_;
+};
+
 /*************************************************************************
  * Applications
  ************************************************************************/
@@ -182,12 +3449,31 @@ std::unique_ptr<IValueModifier> createValueModifier(IValueModifierFactory& value
   return value_modifier_factory.makeValueModifier(mod_type);
 }
 
+/**
+ * @brief Parse a whole command-line argument as a finite number greater than zero (or equal, if `allow_zero`).
+ */
+template <typename T>
+T parsePositiveArgument(const std::string& arg, const std::string& name, const bool allow_zero = false)
+{
+  T value{};
+  const char* end = arg.data() + arg.size();
+  const auto [ptr, ec] = std::from_chars(arg.data(), end, value);
+  if (ec != std::errc() || ptr != end || !(value > 0 || (allow_zero && value == 0)) ||
+      !std::isfinite(static_cast<double>(value)))
+  {
+    throw std::runtime_error("Invalid " + name + " '" + arg + "': expected a number " +
+                             (allow_zero ? "no less than zero" : "greater than zero"));
+  }
+  return value;
+}
+
 /**
  * @brief An application that creates its own value modifiers (given e.g., a class of modifier types)
  */
 void ComplexApplication(IValueModifierFactory& value_modifier_factory,
                         IValueModifierFactory::ModifierType mod_type,
-                        const double clipping_limit)
+                        const double clipping_limit,
+                        SolverProfiler* profiler = nullptr)
 {
   std::unique_ptr<IValueModifier> val_modifier_ptr = createValueModifier(value_modifier_factory, mod_type);
   Solver solver(clipping_limit, std::move(val_modifier_ptr));
@@ -196,14 +3482,24 @@ void ComplexApplication(IValueModifierFactory& value_modifier_factory,
   std::vector<double> vals(n);
   std::iota(vals.begin(), vals.end(), 0);
 
-  std::cout << "Solver w/ clipping_limit: " << std::to_string(clipping_limit) << std::endl;
-  for (const auto v : vals)
+  std::vector<double> slns(n);
   {
-    const MessageData data(v);
-    solver.updateDataCb(data);
+    std::unique_ptr<SolverProfiler::Scope> scope;
+    if (profiler)
+    {
+      scope = std::make_unique<SolverProfiler::Scope>(*profiler, mod_type, n);
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+      solver.updateDataCb(MessageData(vals[i]));
+      slns[i] = solver.solve();
+    }
+  }
 
-    const double sln = solver.solve();
-    std::cout << "input: = " << data.get_val() << ", output: " << std::to_string(sln) << std::endl;
+  std::cout << "Solver w/ clipping_limit: " << std::to_string(clipping_limit) << std::endl;
+  for (size_t i = 0; i < n; ++i)
+  {
+    std::cout << "input: = " << vals[i] << ", output: " << std::to_string(slns[i]) << std::endl;
   }
 }
 
@@ -221,15 +3517,379 @@ void SimpleApplication(std::unique_ptr<IValueModifier> value_modifier_ptr, const
   std::vector<double> vals(n);
   std::iota(vals.begin(), vals.end(), 0);
 
+  // keep formatting out of the solve loop, which must stay allocation-free
+  std::vector<double> slns(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    solver.updateDataCb(MessageData(vals[i]));
+    slns[i] = solver.solve();
+  }
+
+  std::cout << "Solver w/ clipping_limit: " << std::to_string(clipping_limit) << std::endl;
+  for (size_t i = 0; i < n; ++i)
+  {
+    std::cout << "input: = " << vals[i] << ", output: " << std::to_string(slns[i]) << std::endl;
+  }
+}
+
+/**
+ * @brief An application that keeps per-window output distributions instead of every output
+ */
+void AggregatedApplication(std::unique_ptr<IValueModifier> value_modifier_ptr,
+                           const double clipping_limit,
+                           const size_t n = 100000,
+                           const uint64_t window_size = 25000)
+{
+  Solver solver(clipping_limit, std::move(value_modifier_ptr));
+  OutputAggregator aggregator(clipping_limit, window_size);
+
+  // outputs are folded into the aggregator one chunk at a time and never stored beyond that
+  constexpr size_t kBatchSize = 256;
+  MessageData msgs[kBatchSize];
+  double slns[kBatchSize];
+  for (size_t begin = 0; begin < n; begin += kBatchSize)
+  {
+    const size_t count = std::min(kBatchSize, n - begin);
+    for (size_t i = 0; i < count; ++i)
+    {
+      msgs[i] = MessageData(0.00007 * static_cast<double>(begin + i));
+    }
+    solver.solveBatch(msgs, slns, count);
+    aggregator.add(slns, count);
+  }
+
+  std::cout << "Solver w/ clipping_limit: " << std::to_string(clipping_limit) << std::endl;
+  size_t window_idx = 0;
+  for (const auto& window : aggregator.takeCompletedWindows())
+  {
+    std::cout << "window " << window_idx++ << ": count: " << window.count << ", clipped: " << window.clipped_count
+              << ", min: " << std::to_string(window.min) << ", max: " << std::to_string(window.max)
+              << ", mean: " << std::to_string(window.mean())
+              << ", p50: " << std::to_string(window.quantiles.quantile(0.5))
+              << ", p99: " << std::to_string(window.quantiles.quantile(0.99)) << std::endl;
+  }
+}
+
+/**
+ * @brief An application comparing several modifier types on the same input stream in one pass
+ */
+void EnsembleApplication(IValueModifierFactory& value_modifier_factory,
+                         const std::vector<IValueModifierFactory::ModifierType>& mod_types,
+                         const double clipping_limit)
+{
+  EnsembleSolver solver(clipping_limit, value_modifier_factory, mod_types);
+
+  const size_t n = 10;
+  std::vector<MessageData> msgs;
+  for (size_t i = 1; i <= n; ++i)
+  {
+    msgs.emplace_back(static_cast<double>(i));
+  }
+
+  std::vector<double> slns(n * solver.numModifiers());
+  solver.solveBatch(msgs.data(), slns.data(), n);
+
   std::cout << "Solver w/ clipping_limit: " << std::to_string(clipping_limit) << std::endl;
-  for (const auto v : vals)
+  for (size_t i = 0; i < n; ++i)
+  {
+    std::cout << "input: = " << msgs[i].get_val() << ", outputs:";
+    for (size_t m = 0; m < solver.numModifiers(); ++m)
+    {
+      std::cout << " " << modifierTypeName(mod_types[m]) << "=" << std::to_string(slns[i * solver.numModifiers() + m]);
+    }
+    std::cout << std::endl;
+  }
+}
+
+/**
+ * @brief Command-line load generator: loadgen [rate/s] [threads] [seconds] [p99 SLO us] [fixed|poisson]
+ *
+ * Reports latency percentiles at the requested rate, then searches for the maximum rate meeting the SLO.
+ */
+int LoadGeneratorApplication(IValueModifierFactory& value_modifier_factory, const std::vector<std::string>& args)
+{
+  LoadGeneratorConfig config;
+  config.mod_types = {IValueModifierFactory::ModifierType::SQUARE, IValueModifierFactory::ModifierType::LOG};
+  double slo_us = 10.0;
+  try
+  {
+    config.rate_per_sec = args.size() > 0 ? parsePositiveArgument<double>(args[0], "rate") : 1e6;
+    config.num_threads = args.size() > 1 ? parsePositiveArgument<size_t>(args[1], "thread count") : 2;
+    config.duration_sec = args.size() > 2 ? parsePositiveArgument<double>(args[2], "duration") : 1.0;
+    slo_us = args.size() > 3 ? parsePositiveArgument<double>(args[3], "p99 SLO") : slo_us;
+    if (args.size() > 4 && args[4] != "fixed" && args[4] != "poisson")
+    {
+      throw std::runtime_error("Invalid arrival process '" + args[4] + "': expected fixed or poisson");
+    }
+  }
+  catch (const std::runtime_error& e)
+  {
+    std::cerr << e.what() << std::endl
+              << "Usage: loadgen [rate/s] [threads] [seconds] [p99 SLO us] [fixed|poisson]" << std::endl;
+    return 1;
+  }
+  if (args.size() > 4 && args[4] == "poisson")
+  {
+    config.arrival = LoadGeneratorConfig::Arrival::POISSON;
+  }
+
+  std::cout << "*****Running load generator at " << config.rate_per_sec << "/s on " << config.num_threads
+            << " thread(s)*****" << std::endl;
+  reportLoadGeneratorResult(runLoadGenerator(value_modifier_factory, config), std::cout);
+
+  const double max_rate = findMaxSustainableRate(value_modifier_factory, config, static_cast<uint64_t>(slo_us * 1e3));
+  std::cout << "max sustainable rate for p99 <= " << slo_us << "us: " << static_cast<uint64_t>(max_rate) << "/s"
+            << std::endl;
+  return 0;
+}
+
+/**
+ * @brief Two-process example: a forked producer publishes batches that the parent solves over shared memory.
+ */
+int ShmChannelApplication(IValueModifierFactory& value_modifier_factory,
+                          const double clipping_limit,
+                          const uint64_t num_batches = 1 << 20)
+{
+#ifdef __linux__
+  const uint32_t batch_size = 16;
+  ShmRingChannel channel = ShmRingChannel::createAnonymous(1024, batch_size);
+
+  const pid_t pid = fork();
+  if (pid < 0)
+  {
+    throw std::runtime_error("fork failed");
+  }
+  if (pid == 0)
+  {
+    for (uint64_t b = 0; b < num_batches; ++b)
+    {
+      MessageData* batch = channel.beginBatch();
+      for (uint32_t i = 0; i < batch_size; ++i)
+      {
+        batch[i] = MessageData(static_cast<double>(i + 1));
+      }
+      channel.publishBatch(batch_size);
+    }
+    channel.close();
+    _exit(0);
+  }
+
+  Solver square_solver(clipping_limit,
+                       value_modifier_factory.makeValueModifier(IValueModifierFactory::ModifierType::SQUARE));
+  Solver log_solver(clipping_limit, value_modifier_factory.makeValueModifier(IValueModifierFactory::ModifierType::LOG));
+  ShmSolverConsumer consumer(channel, {&square_solver, &log_solver});
+
+  std::vector<double> sums(2, 0.0);
+  const auto start = std::chrono::steady_clock::now();
+  const uint64_t consumed = consumer.run([&sums](size_t s, const MessageData*, const double* out, uint32_t count) {
+    sums[s] = std::accumulate(out, out + count, sums[s]);
+  });
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  waitpid(pid, nullptr, 0);
+
+  std::cout << "consumed " << consumed << " messages in " << num_batches << " batches, "
+            << std::to_string(1e9 * seconds / static_cast<double>(num_batches)) << " ns/batch" << std::endl;
+  std::cout << "sum of SQUARE outputs: " << std::to_string(sums[0])
+            << ", sum of LOG outputs: " << std::to_string(sums[1]) << std::endl;
+  return 0;
+#else
+  (void)value_modifier_factory;
+  (void)clipping_limit;
+  (void)num_batches;
+  std::cout << "Shared-memory channel requires Linux" << std::endl;
+  return 1;
+#endif
+}
+
+/**
+ * @brief An application feeding critical and best-effort streams through the DeadlineScheduler under overload
+ */
+void ScheduledApplication(IValueModifierFactory& value_modifier_factory, const double clipping_limit)
+{
+  using Policy = DeadlineScheduler::StreamPolicy;
+
+  DeadlineScheduler scheduler;
+  std::vector<DeadlineScheduler::StreamId> critical;
+  std::vector<DeadlineScheduler::StreamId> bulk;
+  for (size_t i = 0; i < 2; ++i)
+  {
+    critical.push_back(scheduler.createStream(
+        value_modifier_factory, IValueModifierFactory::ModifierType::LOG, clipping_limit, Policy::critical(50000)));
+  }
+  for (size_t i = 0; i < 4; ++i)
+  {
+    bulk.push_back(scheduler.createStream(
+        value_modifier_factory, IValueModifierFactory::ModifierType::SQUARE, clipping_limit, Policy::bestEffort(256)));
+  }
+
+  // every round offers more bulk work than is served, so the bulk backlogs overflow
+  auto ignore = [](DeadlineScheduler::StreamId, const MessageData*, const double*, size_t) {};
+  for (size_t round = 0; round < 1000; ++round)
+  {
+    for (const auto id : critical)
+    {
+      scheduler.submit(id, MessageData(1.0 + static_cast<double>(round)));
+    }
+    for (const auto id : bulk)
+    {
+      for (size_t i = 0; i < 100; ++i)
+      {
+        scheduler.submit(id, MessageData(static_cast<double>(i)));
+      }
+    }
+    for (size_t step = 0; step < 4; ++step)
+    {
+      scheduler.runOnce(ignore);
+    }
+  }
+  scheduler.drain(ignore);
+
+  for (const auto id : critical)
+  {
+    const auto& stats = scheduler.stats(id);
+    std::cout << "critical stream " << id << ": processed: " << stats.processed
+              << ", deadline misses: " << stats.deadline_misses << std::endl;
+  }
+  for (const auto id : bulk)
+  {
+    const auto& stats = scheduler.stats(id);
+    std::cout << "best-effort stream " << id << ": processed: " << stats.processed << ", dropped: " << stats.dropped
+              << std::endl;
+  }
+}
+
+/**
+ * @brief Select (or load the cached selection of) the fastest modifier implementations for this host.
+ *
+ * Usage: autotune [profile path] [tolerance]
+ */
+int AutotuneApplication(const std::vector<std::string>& args, const double clipping_limit)
+{
+  const std::string profile_path = args.size() > 0 ? args[0] : "value_modifiers.profile";
+  double tolerance = 1e-6;
+  try
+  {
+    tolerance = args.size() > 1 ? parsePositiveArgument<double>(args[1], "tolerance", true) : tolerance;
+  }
+  catch (const std::runtime_error& e)
   {
-    const MessageData data(v);
-    solver.updateDataCb(data);
+    std::cerr << e.what() << std::endl << "Usage: autotune [profile path] [tolerance]" << std::endl;
+    return 1;
+  }
+
+  // SimpleApplication() below drives its Solver one message at a time
+  using Usage = AutotuningValueModifierFactory::Usage;
+  AutotuningValueModifierFactory factory(profile_path, tolerance, Usage::PER_MESSAGE);
+  std::cout << (factory.loadedFromProfile() ? "Loaded" : "Benchmarked and saved") << " profile " << profile_path
+            << std::endl;
+  for (const auto mod_type : {IValueModifierFactory::ModifierType::SQUARE, IValueModifierFactory::ModifierType::LOG})
+  {
+    std::cout << modifierTypeName(mod_type) << ": per-message="
+              << factory.selectedImplementation(mod_type, Usage::PER_MESSAGE)
+              << ", batch=" << factory.selectedImplementation(mod_type, Usage::BATCH) << std::endl;
+  }
+
+  std::cout << "*****Running Application() for autotuned Log modifier*****" << std::endl;
+  SimpleApplication(factory.makeValueModifier(IValueModifierFactory::ModifierType::LOG), clipping_limit);
+  return 0;
+}
+
+/*************************************************************************
+ * Benchmarks
+ ************************************************************************/
+
+// #include <profiling/perf_counters.h>
+// #include <value_modifier_factory_interface.h>
+
+/**
+ * @brief Run a solve loop for each modifier type, recording counters per type.
+ *
+ * @param batched Use Solver::solveBatch() instead of per-message updateDataCb()/solve() calls.
+ */
+void RunModifierBenchmarks(IValueModifierFactory& value_modifier_factory,
+                           SolverProfiler& profiler,
+                           const double clipping_limit,
+                           const bool batched,
+                           const size_t n = 1 << 20)
+{
+  std::vector<MessageData> msgs;
+  msgs.reserve(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    msgs.emplace_back(1.0 + static_cast<double>(i % 1000));
+  }
+  std::vector<double> out(n);
+
+  for (const auto mod_type : {IValueModifierFactory::ModifierType::SQUARE, IValueModifierFactory::ModifierType::LOG})
+  {
+    Solver solver(clipping_limit, value_modifier_factory.makeValueModifier(mod_type));
+
+    SolverProfiler::Scope scope(profiler, mod_type, n);
+    if (batched)
+    {
+      solver.solveBatch(msgs.data(), out.data(), n);
+      continue;
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+      solver.updateDataCb(msgs[i]);
+      out[i] = solver.solve();
+    }
+  }
+}
+
+/**
+ * @brief Measure compression ratio and encode/decode throughput on a slowly varying sensor-like feed.
+ *
+ * Decode runs at roughly 2 GB/s; encode stays near 1 GB/s because each value's XOR window search and
+ * branchy bit packing is serial, so encode does not reach multiple GB/s on a single core.
+ */
+void RunCompressionBenchmark(const size_t n = 1 << 22)
+{
+  // a 0.01-resolution random walk that mostly repeats its last reading, as a quantized sensor would report
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<int> step(-2, 2);
+  std::vector<double> vals(n);
+  std::vector<int64_t> timestamps(n);
+  int64_t level = 10000;
+  for (size_t i = 0; i < n; ++i)
+  {
+    level += rng() % 8 == 0 ? step(rng) : 0;
+    vals[i] = static_cast<double>(level) / 100.0;
+    timestamps[i] = 1700000000000000000 + static_cast<int64_t>(i) * 1000000 + (i % 16 == 0 ? 3 : 0);
+  }
+
+  DoubleColumn value_column;
+  Int64Column timestamp_column;
+  const auto encode_start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < n; ++i)
+  {
+    value_column.append(vals[i]);
+    timestamp_column.append(timestamps[i]);
+  }
+  value_column.finish();
+  timestamp_column.finish();
+  const double encode_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - encode_start).count();
 
-    const double sln = solver.solve();
-    std::cout << "input: = " << data.get_val() << ", output: " << std::to_string(sln) << std::endl;
+  std::vector<double> decoded_vals(DoubleColumn::kBlockSize);
+  std::vector<int64_t> decoded_timestamps(Int64Column::kBlockSize);
+  DoubleColumn::Reader value_reader(value_column);
+  Int64Column::Reader timestamp_reader(timestamp_column);
+  const auto decode_start = std::chrono::steady_clock::now();
+  while (value_reader.read(decoded_vals.data(), decoded_vals.size()) > 0)
+  {
+  }
+  while (timestamp_reader.read(decoded_timestamps.data(), decoded_timestamps.size()) > 0)
+  {
   }
+  const double decode_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - decode_start).count();
+
+  const double raw_bytes = static_cast<double>(n * (sizeof(double) + sizeof(int64_t)));
+  std::cout << "values: " << std::to_string(static_cast<double>(n * sizeof(double)) / value_column.compressedBytes())
+            << "x, timestamps: "
+            << std::to_string(static_cast<double>(n * sizeof(int64_t)) / timestamp_column.compressedBytes())
+            << "x, encode: " << std::to_string(raw_bytes / encode_sec / 1e9)
+            << " GB/s, decode: " << std::to_string(raw_bytes / decode_sec / 1e9) << " GB/s" << std::endl;
 }
 
 /*************************************************************************
@@ -238,12 +3898,25 @@ void SimpleApplication(std::unique_ptr<IValueModifier> value_modifier_ptr, const
 
 // #include <value_modifier_factory.h>
 
-int main()
+int main(int argc, char** argv)
 {
   const double clipping_limit = 42;
 
   ValueModifierFactory factory;
 
+  if (argc > 1 && std::string(argv[1]) == "loadgen")
+  {
+    return LoadGeneratorApplication(factory, std::vector<std::string>(argv + 2, argv + argc));
+  }
+  if (argc > 1 && std::string(argv[1]) == "autotune")
+  {
+    return AutotuneApplication(std::vector<std::string>(argv + 2, argv + argc), clipping_limit);
+  }
+  if (argc > 1 && std::string(argv[1]) == "shm")
+  {
+    return ShmChannelApplication(factory, clipping_limit);
+  }
+
   std::cout << "*****Running Application() for Square modifier*****" << std::endl;
   std::unique_ptr<IValueModifier> value_modifier =
       factory.makeValueModifier(IValueModifierFactory::ModifierType::SQUARE);
@@ -253,13 +3926,47 @@ int main()
   value_modifier = factory.makeValueModifier(IValueModifierFactory::ModifierType::LOG);
   SimpleApplication(std::move(value_modifier), clipping_limit);
 
-#if 0
-  std::cout << "*****Running Application() for Square modifier*****" << std::endl;
-  ComplexApplication(factory, IValueModifierFactory::ModifierType::SQUARE, clipping_limit);
+  std::cout << "*****Running Application() for Expression modifier*****" << std::endl;
+  value_modifier = factory.makeExpressionValueModifier("clamp(log(x*x)+3, 0, 42)");
+  SimpleApplication(std::move(value_modifier), clipping_limit);
 
-  std::cout << "*****Running Application() for Log modifier*****" << std::endl;
-  ComplexApplication(factory, IValueModifierFactory::ModifierType::LOG, clipping_limit);
-#endif
+  SolverProfiler app_profiler;
+
+  std::cout << "*****Running ComplexApplication() for Square modifier*****" << std::endl;
+  ComplexApplication(factory, IValueModifierFactory::ModifierType::SQUARE, clipping_limit, &app_profiler);
+
+  std::cout << "*****Running ComplexApplication() for Log modifier*****" << std::endl;
+  ComplexApplication(factory, IValueModifierFactory::ModifierType::LOG, clipping_limit, &app_profiler);
+
+  std::cout << "*****ComplexApplication() profile*****" << std::endl;
+  app_profiler.report(std::cout);
+
+  std::cout << "*****Running AggregatedApplication() for Square modifier*****" << std::endl;
+  AggregatedApplication(factory.makeValueModifier(IValueModifierFactory::ModifierType::SQUARE), clipping_limit);
+
+  std::cout << "*****Running EnsembleApplication() for Square and Log modifiers*****" << std::endl;
+  EnsembleApplication(factory,
+                      {IValueModifierFactory::ModifierType::SQUARE, IValueModifierFactory::ModifierType::LOG},
+                      clipping_limit);
+
+  std::cout << "*****Running ScheduledApplication() for critical Log and best-effort Square streams*****"
+            << std::endl;
+  ScheduledApplication(factory, clipping_limit);
+
+  for (const bool batched : {false, true})
+  {
+    std::cout << "*****Running " << (batched ? "batched" : "per-message") << " modifier benchmarks*****" << std::endl;
+    SolverProfiler profiler;
+    if (!profiler.countersAvailable())
+    {
+      std::cout << "Hardware counters unavailable, reporting timing only" << std::endl;
+    }
+    RunModifierBenchmarks(factory, profiler, clipping_limit, batched);
+    profiler.report(std::cout);
+  }
+
+  std::cout << "*****Running compressed history benchmark*****" << std::endl;
+  RunCompressionBenchmark();
 
   return 0;
 }
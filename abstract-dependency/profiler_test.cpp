@@ -0,0 +1,44 @@
+// profiler_test.cpp
+
+// #include <profiling/perf_counters.h>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+/*************************************************************************
+ * Unit Tests
+ ************************************************************************/
+
+TEST(SolverProfilerTest, scopeAttributesCallsToModifierType)
+{
+  SolverProfiler profiler;
+  const auto mod_type = IValueModifierFactory::ModifierType::LOG;
+
+  {
+    SolverProfiler::Scope scope(profiler, mod_type, 10);
+  }
+  {
+    SolverProfiler::Scope scope(profiler, mod_type, 5);
+  }
+
+  ASSERT_EQ(1u, profiler.samples().count(mod_type));
+  const PerfSample& sample = profiler.samples().at(mod_type);
+  EXPECT_EQ(15u, sample.calls);
+  EXPECT_GE(sample.seconds, 0.0);
+  EXPECT_EQ(profiler.countersAvailable(), sample.has_counters);
+}
+
+TEST(SolverProfilerTest, reportListsEachProfiledType)
+{
+  SolverProfiler profiler;
+  {
+    SolverProfiler::Scope scope(profiler, IValueModifierFactory::ModifierType::SQUARE, 1);
+  }
+
+  std::ostringstream os;
+  profiler.report(os);
+
+  EXPECT_NE(std::string::npos, os.str().find("SQUARE"));
+  EXPECT_EQ(std::string::npos, os.str().find("LOG"));
+}
@@ -0,0 +1,140 @@
+// scheduler_test.cpp
+
+// #include <scheduling/deadline_scheduler.h>
+// #include <value_modifier_factory.h>
+
+#include <gtest/gtest.h>
+
+#include <functional>
+
+/*************************************************************************
+ * Unit Tests
+ ************************************************************************/
+
+namespace
+{
+uint64_t fake_now_ns = 0;
+
+uint64_t fakeClock()
+{
+  return fake_now_ns;
+}
+}  // namespace
+
+class DeadlineSchedulerTest : public ::testing::Test
+{
+ protected:
+  using Policy = DeadlineScheduler::StreamPolicy;
+  using ModifierType = IValueModifierFactory::ModifierType;
+
+  void SetUp() override
+  {
+    fake_now_ns = 0;
+  }
+
+  ValueModifierFactory factory_;
+  std::vector<std::pair<DeadlineScheduler::StreamId, double>> order_;
+
+  std::function<void(DeadlineScheduler::StreamId, const MessageData*, const double*, size_t)> recorder()
+  {
+    return [this](DeadlineScheduler::StreamId id, const MessageData* msgs, const double*, size_t n) {
+      for (size_t i = 0; i < n; ++i)
+      {
+        order_.emplace_back(id, msgs[i].get_val());
+      }
+    };
+  }
+};
+
+TEST_F(DeadlineSchedulerTest, criticalWorkRunsEarliestDeadlineFirst)
+{
+  DeadlineScheduler scheduler(8, &fakeClock);
+  const auto loose = scheduler.createStream(factory_, ModifierType::SQUARE, 42.0, Policy::critical(1000));
+  const auto tight = scheduler.createStream(factory_, ModifierType::SQUARE, 42.0, Policy::critical(100));
+  const auto bulk = scheduler.createStream(factory_, ModifierType::SQUARE, 42.0, Policy::bestEffort(16));
+
+  scheduler.submit(bulk, MessageData(0));
+  scheduler.submit(loose, MessageData(1));  // deadline 1000
+  fake_now_ns = 10;
+  scheduler.submit(tight, MessageData(2));  // deadline 110
+
+  EXPECT_EQ(3u, scheduler.drain(recorder()));
+
+  const std::vector<std::pair<DeadlineScheduler::StreamId, double>> expected{{tight, 2}, {loose, 1}, {bulk, 0}};
+  EXPECT_EQ(expected, order_);
+  EXPECT_EQ(0u, scheduler.pending());
+}
+
+TEST_F(DeadlineSchedulerTest, countsDeadlineMisses)
+{
+  DeadlineScheduler scheduler(8, &fakeClock);
+  const auto id = scheduler.createStream(factory_, ModifierType::LOG, 42.0, Policy::critical(100));
+
+  scheduler.submit(id, MessageData(1));
+  scheduler.submit(id, MessageData(2));
+  scheduler.runOnce(recorder());
+  fake_now_ns = 101;
+  scheduler.runOnce(recorder());
+
+  EXPECT_EQ(2u, scheduler.stats(id).processed);
+  EXPECT_EQ(1u, scheduler.stats(id).deadline_misses);
+  EXPECT_EQ(1u, scheduler.totalDeadlineMisses());
+}
+
+TEST_F(DeadlineSchedulerTest, bestEffortStreamsAreBatchedRoundRobinAndBounded)
+{
+  DeadlineScheduler scheduler(4, &fakeClock);
+  const auto a = scheduler.createStream(factory_, ModifierType::SQUARE, 42.0, Policy::bestEffort(6));
+  const auto b = scheduler.createStream(factory_, ModifierType::SQUARE, 42.0, Policy::bestEffort(6));
+
+  for (int i = 0; i < 8; ++i)
+  {
+    scheduler.submit(a, MessageData(i));
+  }
+  scheduler.submit(b, MessageData(100));
+
+  EXPECT_EQ(2u, scheduler.stats(a).dropped);
+  EXPECT_EQ(7u, scheduler.pending());
+
+  EXPECT_EQ(4u, scheduler.runOnce(recorder()));
+  EXPECT_EQ(1u, scheduler.runOnce(recorder()));
+  EXPECT_EQ(2u, scheduler.runOnce(recorder()));
+  EXPECT_EQ(0u, scheduler.runOnce(recorder()));
+
+  // the two oldest messages of stream a were dropped
+  ASSERT_EQ(7u, order_.size());
+  EXPECT_EQ(std::make_pair(a, 2.0), order_[0]);
+  EXPECT_EQ(std::make_pair(b, 100.0), order_[4]);
+  EXPECT_EQ(std::make_pair(a, 7.0), order_[6]);
+}
+
+TEST_F(DeadlineSchedulerTest, emptyBestEffortQueueIsRejected)
+{
+  DeadlineScheduler scheduler(4, &fakeClock);
+  EXPECT_THROW(scheduler.createStream(factory_, ModifierType::SQUARE, 42.0, Policy::bestEffort(0)),
+               std::runtime_error);
+  EXPECT_EQ(0u, scheduler.pending());
+}
+
+TEST_F(DeadlineSchedulerTest, emptyBestEffortBatchIsRejected)
+{
+  EXPECT_THROW(DeadlineScheduler(0, &fakeClock), std::runtime_error);
+}
+
+TEST_F(DeadlineSchedulerTest, criticalArrivalPreemptsBestEffortBacklog)
+{
+  DeadlineScheduler scheduler(2, &fakeClock);
+  const auto bulk = scheduler.createStream(factory_, ModifierType::SQUARE, 42.0, Policy::bestEffort(100));
+  const auto critical = scheduler.createStream(factory_, ModifierType::SQUARE, 42.0, Policy::critical(10));
+
+  for (int i = 0; i < 10; ++i)
+  {
+    scheduler.submit(bulk, MessageData(i));
+  }
+  scheduler.runOnce(recorder());
+  scheduler.submit(critical, MessageData(-1));
+  scheduler.runOnce(recorder());
+
+  ASSERT_EQ(3u, order_.size());
+  EXPECT_EQ(critical, order_[2].first);
+}
@@ -0,0 +1,132 @@
+// shm_channel_test.cpp
+
+// #include <ipc/shm_ring_channel.h>
+// #include <ipc/shm_solver_consumer.h>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include <unistd.h>
+
+/*************************************************************************
+ * Unit Tests
+ ************************************************************************/
+
+TEST(ShmRingChannelTest, forkedProducerFeedsSolverWithoutLoss)
+{
+  const uint32_t batch_size = 8;
+  const uint64_t num_batches = 10000;
+  ShmRingChannel channel = ShmRingChannel::createAnonymous(4, batch_size);
+
+  const pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0)
+  {
+    for (uint64_t b = 0; b < num_batches; ++b)
+    {
+      MessageData* batch = channel.beginBatch();
+      for (uint32_t i = 0; i < batch_size; ++i)
+      {
+        batch[i] = MessageData(static_cast<double>(b * batch_size + i));
+      }
+      channel.publishBatch(batch_size);
+    }
+    channel.close();
+    _exit(0);
+  }
+
+  ValueModifierFactory factory;
+  Solver solver(1e12, factory.makeValueModifier(IValueModifierFactory::ModifierType::SQUARE));
+  ShmSolverConsumer consumer(channel, {&solver});
+
+  double expected_next = 0;
+  bool in_order = true;
+  const uint64_t consumed = consumer.run([&](size_t, const MessageData* msgs, const double* out, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      in_order = in_order && msgs[i].get_val() == expected_next && out[i] == expected_next * expected_next;
+      expected_next += 1;
+    }
+  });
+
+  int status = -1;
+  waitpid(pid, &status, 0);
+  EXPECT_EQ(0, status);
+  EXPECT_EQ(num_batches * batch_size, consumed);
+  EXPECT_TRUE(in_order);
+}
+
+TEST(ShmRingChannelTest, namedChannelIsVisibleToOpeners)
+{
+  const std::string name = "/shm_ring_channel_test_" + std::to_string(getpid());
+  ShmRingChannel producer = ShmRingChannel::createNamed(name, 2, 4);
+  ShmRingChannel consumer = ShmRingChannel::openNamed(name);
+  ShmRingChannel::unlinkNamed(name);
+
+  ASSERT_EQ(4u, consumer.batchCapacity());
+
+  MessageData* batch = producer.beginBatch();
+  batch[0] = MessageData(3.0);
+  producer.publishBatch(1);
+  producer.close();
+
+  uint32_t count = 0;
+  const MessageData* msgs = consumer.waitBatch(count);
+  ASSERT_NE(nullptr, msgs);
+  EXPECT_EQ(1u, count);
+  EXPECT_EQ(3.0, msgs[0].get_val());
+  consumer.releaseBatch();
+
+  EXPECT_EQ(nullptr, consumer.waitBatch(count));
+  EXPECT_EQ(0u, count);
+}
+
+TEST(ShmRingChannelTest, openingForeignObjectThrows)
+{
+  const std::string name = "/shm_ring_channel_foreign_" + std::to_string(getpid());
+  const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(0, ftruncate(fd, 4096));
+  close(fd);
+
+  EXPECT_THROW(ShmRingChannel::openNamed(name), std::runtime_error);
+  ShmRingChannel::unlinkNamed(name);
+}
+
+TEST(ShmRingChannelTest, openingTruncatedChannelThrows)
+{
+  const std::string name = "/shm_ring_channel_truncated_" + std::to_string(getpid());
+  {
+    ShmRingChannel channel = ShmRingChannel::createNamed(name, 1024, 64);
+  }
+  const int fd = shm_open(name.c_str(), O_RDWR, 0600);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(0, ftruncate(fd, 4096));
+  close(fd);
+
+  EXPECT_THROW(ShmRingChannel::openNamed(name), std::runtime_error);
+  ShmRingChannel::unlinkNamed(name);
+}
+
+TEST(ShmRingChannelTest, emptyGeometryIsRejected)
+{
+  EXPECT_THROW(ShmRingChannel::createAnonymous(0, 16), std::runtime_error);
+  EXPECT_THROW(ShmRingChannel::createAnonymous(16, 0), std::runtime_error);
+}
+
+TEST(ShmRingChannelTest, oversizedBatchCountIsRejected)
+{
+  ShmRingChannel channel = ShmRingChannel::createAnonymous(2, 4);
+  EXPECT_THROW(channel.publishBatch(5), std::runtime_error);
+
+  MessageData* batch = channel.beginBatch();
+  channel.publishBatch(1);
+  // a misbehaving producer process rewrites the published count, which precedes the slot's messages
+  const uint32_t bogus = 100000;
+  std::memcpy(reinterpret_cast<char*>(batch) - alignof(MessageData), &bogus, sizeof(bogus));
+
+  uint32_t count = 0;
+  EXPECT_THROW(channel.waitBatch(count), std::runtime_error);
+  EXPECT_EQ(0u, count);
+}
@@ -0,0 +1,95 @@
+// value_modifier_test.cpp
+
+// #include <value_modifiers/expression_value_modifier.h>
+
+#include <gtest/gtest.h>
+
+/*************************************************************************
+ * Unit Tests
+ ************************************************************************/
+
+TEST(ExpressionValueModifierTest, evaluatesSingleValue)
+{
+  ExpressionValueModifier modifier("clamp(log(x*x)+3, 0, 42)");
+
+  const double in_val = 5.0;
+  modifier.update(MessageData(in_val));
+
+  EXPECT_DOUBLE_EQ(std::log(in_val * in_val) + 3, modifier.generateVal());
+}
+
+TEST(ExpressionValueModifierTest, respectsOperatorPrecedence)
+{
+  ExpressionValueModifier modifier("-x + 2 * (x - 1) / 4");
+
+  modifier.update(MessageData(3.0));
+
+  EXPECT_DOUBLE_EQ(-3.0 + 2 * (3.0 - 1) / 4, modifier.generateVal());
+}
+
+TEST(ExpressionValueModifierTest, batchMatchesScalarAcrossBlocks)
+{
+  ExpressionValueModifier batch_modifier("max(sqrt(abs(x)), exp(-x)) - min(x, 1.5)");
+  ExpressionValueModifier scalar_modifier("max(sqrt(abs(x)), exp(-x)) - min(x, 1.5)");
+
+  const size_t n = 3 * ExpressionValueModifier::kBlockSize + 7;
+  std::vector<MessageData> msgs;
+  for (size_t i = 0; i < n; ++i)
+  {
+    msgs.emplace_back(0.01 * static_cast<double>(i) - 1.0);
+  }
+
+  std::vector<double> out(n);
+  batch_modifier.generateVals(msgs.data(), out.data(), n);
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    scalar_modifier.update(msgs[i]);
+    EXPECT_DOUBLE_EQ(scalar_modifier.generateVal(), out[i]);
+  }
+}
+
+TEST(ExpressionValueModifierTest, invalidExpressionThrows)
+{
+  EXPECT_THROW(ExpressionValueModifier("x +"), std::runtime_error);
+  EXPECT_THROW(ExpressionValueModifier("foo(x)"), std::runtime_error);
+  EXPECT_THROW(ExpressionValueModifier("clamp(x, 1)"), std::runtime_error);
+  EXPECT_THROW(ExpressionValueModifier("(x"), std::runtime_error);
+  EXPECT_THROW(ExpressionValueModifier("1e999*x"), std::runtime_error);
+  EXPECT_THROW(ExpressionValueModifier("."), std::runtime_error);
+  EXPECT_THROW(ExpressionValueModifier("x + 0x10"), std::runtime_error);
+  EXPECT_THROW(ExpressionValueModifier("x * 2e"), std::runtime_error);
+  EXPECT_THROW(ExpressionValueModifier(std::string(200000, '(') + "x" + std::string(200000, ')')), std::runtime_error);
+  EXPECT_THROW(ExpressionValueModifier(std::string(200000, '-') + "x"), std::runtime_error);
+}
+
+TEST(ExpressionValueModifierTest, moderateNestingIsAccepted)
+{
+  ExpressionValueModifier modifier(std::string(100, '(') + "-x" + std::string(100, ')'));
+
+  modifier.update(MessageData(3.0));
+
+  EXPECT_DOUBLE_EQ(-3.0, modifier.generateVal());
+}
+
+TEST(ExpressionValueModifierTest, parsesDecimalLiterals)
+{
+  ExpressionValueModifier modifier("x * 1.5e2 + .25 - 2.");
+
+  modifier.update(MessageData(2.0));
+
+  EXPECT_DOUBLE_EQ(2.0 * 150 + 0.25 - 2.0, modifier.generateVal());
+}
+
+TEST(ExpressionValueModifierTest, solverClipsBatchOutput)
+{
+  ValueModifierFactory factory;
+  Solver solver(10.0, factory.makeExpressionValueModifier("x * x"));
+
+  const std::vector<MessageData> msgs{MessageData(2.0), MessageData(4.0)};
+  std::vector<double> out(msgs.size());
+  solver.solveBatch(msgs.data(), out.data(), msgs.size());
+
+  EXPECT_DOUBLE_EQ(4.0, out[0]);
+  EXPECT_DOUBLE_EQ(10.0, out[1]);
+}